@@ -770,6 +770,29 @@ s64 FileSystem::FSize64(std::FILE* fp)
 	return -1;
 }
 
+int FileSystem::FTruncate64(std::FILE* fp, s64 size)
+{
+	// Anything still buffered would be written past the new end.
+	if (std::fflush(fp) != 0)
+		return -1;
+
+#ifdef _WIN32
+	const int fd = _fileno(fp);
+	if (fd < 0)
+		return -1;
+
+	return (_chsize_s(fd, size) == 0) ? 0 : -1;
+#else
+	if constexpr (sizeof(off_t) != sizeof(s64))
+	{
+		if (size < 0 || size > std::numeric_limits<off_t>::max())
+			return -1;
+	}
+
+	return ftruncate(fileno(fp), static_cast<off_t>(size));
+#endif
+}
+
 s64 FileSystem::GetPathFileSize(const char* Path)
 {
 	FILESYSTEM_STAT_DATA sd;
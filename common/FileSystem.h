@@ -118,6 +118,7 @@ namespace FileSystem
 	int FSeek64(std::FILE* fp, s64 offset, int whence);
 	s64 FTell64(std::FILE* fp);
 	s64 FSize64(std::FILE* fp);
+	int FTruncate64(std::FILE* fp, s64 size);
 
 	int OpenFDFile(const char* filename, int flags, int mode, Error* error = nullptr);
 
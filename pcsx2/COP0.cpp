@@ -17,6 +17,7 @@
 #include "PrecompiledHeader.h"
 #include "Common.h"
 #include "COP0.h"
+#include "Cache.h"
 
 // Updates the CPU's mode of operation (either, Kernel, Supervisor, or User modes).
 // Currently the different modes are not implemented.
@@ -43,8 +44,13 @@ void WriteCP0Status(u32 value) {
 
 void WriteCP0Config(u32 value) {
 	// Protect the read-only ICacheSize (IC) and DataCacheSize (DC) bits
+	const u32 old_config = cpuRegs.CP0.n.Config;
 	cpuRegs.CP0.n.Config = value & ~0xFC0;
 	cpuRegs.CP0.n.Config |= 0x440;
+
+	// data cache enable
+	if (CHECK_CACHE && ((old_config ^ cpuRegs.CP0.n.Config) & 0x10000))
+		updateCacheablePages();
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -334,6 +340,9 @@ void WriteTLB(int i)
 	tlb[i].S = cpuRegs.CP0.n.EntryLo0&0x80000000;
 
 	MapTLB(tlb[i], i);
+
+	if (CHECK_CACHE)
+		updateCacheablePages();
 }
 
 namespace R5900 {
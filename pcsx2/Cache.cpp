@@ -161,11 +161,46 @@ namespace
 
 	static Cache cache;
 
+	static_assert(sizeof(CacheSet) == CACHE_SET_SIZE && offsetof(CacheSet, data) == CACHE_LINE_OFFSET);
+	static_assert(CacheTag::DIRTY_FLAG == CACHE_TAG_DIRTY && CacheTag::VALID_FLAG == CACHE_TAG_VALID &&
+				  CacheTag::ALL_FLAGS == CACHE_TAG_FLAGS);
+
+}
+
+u32 cacheablePages[0x100000 / 32];
+
+static void markCacheablePages(u32 pfn, u32 mask)
+{
+	const u32 end = (pfn + mask) >> 12;
+	for (u32 page = pfn >> 12; page <= end; page++)
+		cacheablePages[page / 32] |= 1u << (page % 32);
+}
+
+// Page granular version of the checks the interpreter used to do per access: the cache has
+// to be enabled in Config, and the address covered by a TLB entry in cached (mode 3) mode.
+// Note the interpreter checked the byte range [PFN, PFN + PageMask], which only covered the
+// first byte of 4KB pages (PageMask 0); now every page the range touches is cached as a whole,
+// as the real cache attribute applies to the entire page.
+void updateCacheablePages()
+{
+	std::memset(cacheablePages, 0, sizeof(cacheablePages));
+
+	if (((cpuRegs.CP0.n.Config >> 16) & 0x1) == 0)
+		return;
+
+	for (int i = 1; i < 48; i++)
+	{
+		if (((tlb[i].EntryLo1 & 0x38) >> 3) == 0x3)
+			markCacheablePages(tlb[i].PFN1, tlb[i].PageMask);
+		if (((tlb[i].EntryLo0 & 0x38) >> 3) == 0x3)
+			markCacheablePages(tlb[i].PFN0, tlb[i].PageMask);
+	}
 }
 
 void resetCache()
 {
 	std::memset(&cache, 0, sizeof(cache));
+	updateCacheablePages();
 }
 
 static bool findInCache(const CacheSet& set, uptr ppf, int* way)
@@ -305,6 +340,39 @@ RETURNS_R128 readCache128(u32 mem)
 	return value;
 }
 
+void* getCacheBase()
+{
+	return &cache;
+}
+
+// Miss path of the recompiler's inline tag check.
+template <bool Write>
+static void* prepareCacheLine(u32 mem, u32 bytes)
+{
+	int way, idx;
+	switch (bytes)
+	{
+		case 1: return prepareCacheAccess<Write, 1>(mem, &way, &idx);
+		case 2: return prepareCacheAccess<Write, 2>(mem, &way, &idx);
+		case 4: return prepareCacheAccess<Write, 4>(mem, &way, &idx);
+		case 8: return prepareCacheAccess<Write, 8>(mem, &way, &idx);
+		case 16: return prepareCacheAccess<Write, 16>(mem, &way, &idx);
+		jNO_DEFAULT
+	}
+
+	return nullptr;
+}
+
+void* readCacheLine(u32 mem, u32 bytes)
+{
+	return prepareCacheLine<false>(mem, bytes);
+}
+
+void* writeCacheLine(u32 mem, u32 bytes)
+{
+	return prepareCacheLine<true>(mem, bytes);
+}
+
 template <typename Op>
 void doCacheHitOp(u32 addr, const char* name, Op op)
 {
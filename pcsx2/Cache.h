@@ -29,3 +29,21 @@ u16 readCache16(u32 mem);
 u32 readCache32(u32 mem);
 u64 readCache64(u32 mem);
 RETURNS_R128 readCache128(u32 mem);
+
+// Recompiler interface, see recVTLB.cpp.
+// Sets are CACHE_SET_SIZE bytes apart from getCacheBase(), with the two tags at the start of
+// the set and the two 64 byte lines from CACHE_LINE_OFFSET. Tags hold the host address of
+// the line in their upper bits, and the flags below.
+static constexpr u32 CACHE_SET_SIZE = 192;
+static constexpr u32 CACHE_LINE_OFFSET = 64;
+static constexpr u32 CACHE_TAG_DIRTY = 0x40;
+static constexpr u32 CACHE_TAG_VALID = 0x20;
+static constexpr u32 CACHE_TAG_FLAGS = 0xFFF;
+
+// One bit per 4kb page, set when accesses to the page go through the data cache.
+extern u32 cacheablePages[0x100000 / 32];
+
+void updateCacheablePages();
+void* getCacheBase();
+void* readCacheLine(u32 mem, u32 bytes);
+void* writeCacheLine(u32 mem, u32 bytes);
@@ -553,6 +553,8 @@ struct Pcsx2Config
 			EnableFastmem : 1;
 		bool
 			PauseOnTLBMiss : 1;
+		bool
+			EnableVUProgramCache : 1;
 		BITFIELD_END
 
 		RecompilerOptions();
@@ -719,6 +721,11 @@ struct Pcsx2Config
 
 		int VsyncQueueSize = 2;
 
+		// Percentage of the MTGS and MTVU ring buffers the EE is allowed to fill before
+		// it waits on the consumer. Lower values keep the threads more tightly coupled.
+		int MTGSRingLimit = 100;
+		int MTVURingLimit = 100;
+
 		// forces the MTGS to execute tags/tasks in fully blocking/synchronous
 		// style. Useful for debugging potential bugs in the MTGS pipeline.
 		bool SynchronousMTGS = false;
@@ -1381,7 +1388,7 @@ namespace EmuFolders
 #define CHECK_EEREC (EmuConfig.Cpu.Recompiler.EnableEE)
 #define CHECK_CACHE (EmuConfig.Cpu.Recompiler.EnableEECache)
 #define CHECK_IOPREC (EmuConfig.Cpu.Recompiler.EnableIOP)
-#define CHECK_FASTMEM (EmuConfig.Cpu.Recompiler.EnableEE && EmuConfig.Cpu.Recompiler.EnableFastmem)
+#define CHECK_FASTMEM (EmuConfig.Cpu.Recompiler.EnableEE && EmuConfig.Cpu.Recompiler.EnableFastmem && !EmuConfig.Cpu.Recompiler.EnableEECache) // Fastmem accesses bypass the cache.
 
 //------------ SPECIAL GAME FIXES!!! ---------------
 #define CHECK_VUADDSUBHACK (EmuConfig.Gamefixes.VuAddSubHack) // Special Fix for Tri-ace games, they use an encryption algorithm that requires VU addi opcode to be bit-accurate.
@@ -0,0 +1,146 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "common/Assertions.h"
+#include "common/Pcsx2Defs.h"
+
+#include <array>
+
+// --------------------------------------------------------------------------------------
+//  EventQueue
+// --------------------------------------------------------------------------------------
+// Binary min-heap of pending event deadlines, shared by the EE and IOP event tests so
+// they can tell in O(1) whether any scheduled interrupt is due, instead of walking every
+// interrupt source on each branch test.
+//
+// Deadlines are free-running 32-bit cycle counts and are compared wrap-safely, which is
+// fine as long as every queued event lies within 2^31 cycles of the others.
+//
+// The owner's interrupt mask and start/delta cycles remain authoritative: events can be
+// cleared or pushed back without going through the queue, so entries are validated
+// lazily in Peek() and stale ones are dropped or re-queued at their current deadline.
+//
+// get_deadline(id, &deadline) must return false when the event is no longer pending, or
+// its current deadline otherwise. Event ids are bits of the owner's 32-bit interrupt mask.
+class EventQueue
+{
+public:
+	static constexpr u32 CAPACITY = 64;
+	static constexpr u32 MAX_EVENTS = 32;
+
+	void Clear() { m_size = 0; }
+	bool IsFull() const { return m_size == CAPACITY; }
+
+	void Push(u32 id, u32 deadline)
+	{
+		pxAssume(m_size < CAPACITY);
+
+		u32 pos = m_size++;
+		while (pos > 0)
+		{
+			const u32 parent = (pos - 1) / 2;
+			if (!Before(deadline, m_heap[parent].deadline))
+				break;
+
+			m_heap[pos] = m_heap[parent];
+			pos = parent;
+		}
+
+		m_heap[pos] = {deadline, id};
+	}
+
+	// Queues a newly scheduled event. Stale entries pile up when events are rescheduled
+	// faster than they're serviced, so once the queue fills up it's rebuilt instead.
+	template <typename GetDeadline>
+	void Schedule(u32 id, u32 deadline, const GetDeadline& get_deadline)
+	{
+		if (IsFull())
+			Rebuild(get_deadline);
+		else
+			Push(id, deadline);
+	}
+
+	// Replaces the contents with the deadlines of the events which are currently pending.
+	template <typename GetDeadline>
+	void Rebuild(const GetDeadline& get_deadline)
+	{
+		Clear();
+		for (u32 id = 0; id < MAX_EVENTS; id++)
+		{
+			u32 deadline;
+			if (get_deadline(id, &deadline))
+				Push(id, deadline);
+		}
+	}
+
+	// Finds the earliest pending deadline.
+	template <typename GetDeadline>
+	bool Peek(u32* deadline, const GetDeadline& get_deadline)
+	{
+		while (m_size > 0)
+		{
+			const Entry top = m_heap[0];
+			u32 current;
+			const bool pending = get_deadline(top.id, &current);
+			if (pending && current == top.deadline)
+			{
+				*deadline = current;
+				return true;
+			}
+
+			Pop();
+			if (pending)
+				Push(top.id, current);
+		}
+
+		return false;
+	}
+
+private:
+	struct Entry
+	{
+		u32 deadline;
+		u32 id;
+	};
+
+	static bool Before(u32 a, u32 b) { return static_cast<s32>(a - b) < 0; }
+
+	void Pop()
+	{
+		const Entry last = m_heap[--m_size];
+
+		u32 pos = 0;
+		for (;;)
+		{
+			u32 child = pos * 2 + 1;
+			if (child >= m_size)
+				break;
+			if (child + 1 < m_size && Before(m_heap[child + 1].deadline, m_heap[child].deadline))
+				child++;
+			if (!Before(m_heap[child].deadline, last.deadline))
+				break;
+
+			m_heap[pos] = m_heap[child];
+			pos = child;
+		}
+
+		m_heap[pos] = last;
+	}
+
+	std::array<Entry, CAPACITY> m_heap;
+	u32 m_size = 0;
+};
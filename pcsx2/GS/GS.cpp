@@ -437,6 +437,10 @@ int GSfreeze(FreezeAction mode, freezeData* data)
 		// out the current textures.
 		g_gs_device->ClearCurrent();
 
+		// Cached texture hashes are for the local memory we're about to replace.
+		if (g_texture_cache)
+			g_texture_cache->InvalidateAllLocalMemHashes();
+
 		// Dump audio frames in video capture if it's been started, otherwise we get
 		// a buildup of audio frames from the CPU thread.
 		if (GSCapture::IsCapturing())
@@ -36,6 +36,7 @@ GSClut::GSClut(GSLocalMemory* mem)
 	m_buff32 = reinterpret_cast<u32*>(reinterpret_cast<u8*>(m_clut) + 2048); // 1k
 	m_buff64 = reinterpret_cast<u64*>(reinterpret_cast<u8*>(m_clut) + 4096); // 2k
 	m_write.dirty = 1;
+	m_write.source_size = 0;
 	m_read.dirty = true;
 
 	for (int i = 0; i < 16; i++)
@@ -124,10 +125,18 @@ void GSClut::ClearDrawInvalidity()
 {
 	if (m_write.dirty & 2)
 	{
-		m_write.dirty = 1;
+		// The draw may have been to a GPU target, local memory is only updated when the CLUT is reloaded.
+		m_write.dirty = 1 | 4;
 	}
 }
 
+void GSClut::ClearCompareEligibility()
+{
+	// Only matters for a pending reload, setting it alone would force one.
+	if (m_write.dirty)
+		m_write.dirty |= 4;
+}
+
 u32 GSClut::GetCLUTCBP()
 {
 	return m_write.TEX0.CBP;
@@ -143,7 +152,7 @@ void GSClut::SetNextCLUTTEX0(u64 TEX0)
 	m_write.next_tex0 = TEX0;
 }
 
-bool GSClut::InvalidateRange(u32 start_block, u32 end_block, bool is_draw)
+bool GSClut::InvalidateRange(u32 start_block, u32 end_block, bool is_draw, bool local_mem_current)
 {
 	if (m_write.dirty & 2)
 		return m_write.dirty;
@@ -162,7 +171,7 @@ bool GSClut::InvalidateRange(u32 start_block, u32 end_block, bool is_draw)
 
 	if ((next_cbp.CBP + 3U) >= start_block && end_block >= next_cbp.CBP)
 	{
-		m_write.dirty |= is_draw ? 2 : 1;
+		m_write.dirty |= is_draw ? 2 : (local_mem_current ? 1 : (1 | 4));
 	}
 
 	return m_write.dirty;
@@ -206,7 +215,22 @@ bool GSClut::WriteTest(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT)
 	}
 
 	// CLUT only reloads if PSM is a valid index type, avoid unnecessary flushes.
-	return m_write.IsDirty(TEX0, TEXCLUT);
+	if (!m_write.IsDirty(TEX0, TEXCLUT))
+		return false;
+
+	// Lots of games upload the same palette again before every draw which uses it. When the load parameters are the
+	// same and only uploads touched the palette since, compare the data; if it didn't change, reloading would produce
+	// an identical CLUT, so skip it along with the flush, re-expansion and GPU palette update which go with it.
+	if (m_write.dirty == 1 && m_write.source_size != 0 && !m_write.HasKeyChanged(TEX0, TEXCLUT) &&
+		std::memcmp(m_write.source, m_mem->BlockPtr(TEX0.CBP), m_write.source_size) == 0)
+	{
+		m_write.TEX0 = TEX0;
+		m_write.TEXCLUT = TEXCLUT;
+		m_write.dirty = 0;
+		return false;
+	}
+
+	return true;
 }
 
 void GSClut::Write(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT)
@@ -217,6 +241,29 @@ void GSClut::Write(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT)
 	m_write.dirty = 0;
 
 	(this->*m_wc[TEX0.CSM][TEX0.CPSM][TEX0.PSM])(TEX0, TEXCLUT);
+
+	m_write.source_size = GetSourceSize(TEX0);
+	if (m_write.source_size != 0)
+		std::memcpy(m_write.source, m_mem->BlockPtr(TEX0.CBP), m_write.source_size);
+}
+
+u32 GSClut::GetSourceSize(const GIFRegTEX0& TEX0)
+{
+	// CSM2 palettes are scattered across a whole buffer row, and GPU target CLUTs don't come from local memory.
+	if (TEX0.CSM != 0 || GSConfig.UserHacks_GPUTargetCLUTMode != GSGPUTargetCLUTMode::Disabled)
+		return 0;
+
+	// Same block count as the CLUT invalidation in GSState::ApplyTEX0().
+	u32 blocks = 4;
+	if (GSLocalMemory::m_psm[TEX0.CPSM].trbpp == 16)
+		blocks >>= 1;
+	if (GSLocalMemory::m_psm[TEX0.PSM].trbpp == 4)
+		blocks >>= 1;
+
+	if ((TEX0.CBP + blocks) > MAX_BLOCKS)
+		return 0;
+
+	return blocks * BLOCK_SIZE;
 }
 
 void GSClut::WriteCLUT32_I8_CSM1(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT)
@@ -851,16 +898,19 @@ void GSClut::Expand16(const u16* RESTRICT src, u32* RESTRICT dst, int w, const G
 	}
 }
 
-bool GSClut::WriteState::IsDirty(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT)
+bool GSClut::WriteState::HasKeyChanged(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT) const
 {
 	constexpr u64 mask = 0x1FFFFFE000000000ull; // CSA CSM CPSM CBP
 
-	bool is_dirty = dirty;
-
 	if (((this->TEX0.U64 ^ TEX0.U64) & mask) || (GSLocalMemory::m_psm[this->TEX0.PSM].pal != GSLocalMemory::m_psm[TEX0.PSM].pal))
-		is_dirty |= true;
-	else if (TEX0.CSM == 1 && (TEXCLUT.U32[0] ^ this->TEXCLUT.U32[0]))
-		is_dirty |= true;
+		return true;
+
+	return (TEX0.CSM == 1 && (TEXCLUT.U32[0] ^ this->TEXCLUT.U32[0]));
+}
+
+bool GSClut::WriteState::IsDirty(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT)
+{
+	const bool is_dirty = dirty || HasKeyChanged(TEX0, TEXCLUT);
 
 	if (!is_dirty)
 	{
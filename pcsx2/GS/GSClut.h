@@ -40,8 +40,11 @@ class alignas(32) GSClut final : public GSAlignedClass<32>
 	{
 		GIFRegTEX0 TEX0;
 		GIFRegTEXCLUT TEXCLUT;
-		u8 dirty;
+		u8 dirty; // 1: palette memory written, 2: written by a pending draw, 4: local memory may be stale
 		u64 next_tex0;
+		u32 source_size; // bytes of source which are valid, 0 if the last load can't be compared
+		u8 source[1024]; // palette memory as it was when the CLUT was last loaded
+		bool HasKeyChanged(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT) const;
 		bool IsDirty(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT);
 	} m_write;
 
@@ -102,15 +105,20 @@ private:
 
 	static void Expand16(const u16* RESTRICT src, u32* RESTRICT dst, int w, const GIFRegTEXA& TEXA);
 
+	static u32 GetSourceSize(const GIFRegTEX0& TEX0);
+
 public:
 	GSClut(GSLocalMemory* mem);
 	~GSClut();
 
 	__fi GSTexture* GetGPUTexture() const { return m_current_gpu_clut; }
 
-	bool InvalidateRange(u32 start_block, u32 end_block, bool is_draw = false);
+	/// local_mem_current should be set when the new data is written straight to local memory, which lets an
+	/// identical palette upload skip the reload.
+	bool InvalidateRange(u32 start_block, u32 end_block, bool is_draw = false, bool local_mem_current = false);
 	u8 IsInvalid();
 	void ClearDrawInvalidity();
+	void ClearCompareEligibility();
 	u32 GetCLUTCBP();
 	u32 GetCLUTCPSM();
 	void SetNextCLUTTEX0(u64 CBP);
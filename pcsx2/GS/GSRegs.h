@@ -87,6 +87,10 @@ enum GIF_REG_COMPLEX
 {
 	GIF_REG_STQRGBAXYZF2 = 0x00,
 	GIF_REG_STQRGBAXYZ2 = 0x01,
+	GIF_REG_RGBAXYZF2 = 0x02,
+	GIF_REG_RGBAXYZ2 = 0x03,
+	GIF_REG_UVRGBAXYZF2 = 0x04,
+	GIF_REG_UVRGBAXYZ2 = 0x05,
 };
 
 enum GIF_A_D_REG
@@ -1125,7 +1129,11 @@ struct alignas(32) GIFPath
 		TYPE_UNKNOWN,
 		TYPE_ADONLY,
 		TYPE_STQRGBAXYZF2,
-		TYPE_STQRGBAXYZ2
+		TYPE_STQRGBAXYZ2,
+		TYPE_RGBAXYZF2,
+		TYPE_RGBAXYZ2,
+		TYPE_UVRGBAXYZF2,
+		TYPE_UVRGBAXYZ2
 	};
 
 	__forceinline void SetTag(const void* mem)
@@ -1166,6 +1174,11 @@ struct alignas(32) GIFPath
 					case 1:
 						break;
 					case 2:
+						// untextured geometry, HUDs and shadows
+						if (regs.U32[0] == 0x00000401)
+							type = TYPE_RGBAXYZF2;
+						if (regs.U32[0] == 0x00000501)
+							type = TYPE_RGBAXYZ2;
 						break;
 					case 3:
 						// many games, TODO: formats mixed with NOPs (xeno2: 040f010f02, 04010f020f, mgs3: 04010f0f02, 0401020f0f, 04010f020f)
@@ -1174,7 +1187,10 @@ struct alignas(32) GIFPath
 						// GoW (has other crazy formats, like ...030503050103)
 						if (regs.U32[0] == 0x00050102)
 							type = TYPE_STQRGBAXYZ2;
-						// TODO: common types with UV instead
+						if (regs.U32[0] == 0x00040103)
+							type = TYPE_UVRGBAXYZF2;
+						if (regs.U32[0] == 0x00050103)
+							type = TYPE_UVRGBAXYZ2;
 						break;
 					case 4:
 						break;
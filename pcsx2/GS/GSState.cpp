@@ -144,6 +144,7 @@ std::string GSState::GetDrawDumpPath(const char* format, ...)
 void GSState::Reset(bool hardware_reset)
 {
 	Flush(GSFlushReason::RESET);
+	m_upload_thread.WaitForAll();
 
 	// FIXME: bios logo not shown cut in half after reset, missing graphics in GoW after first FMV
 	memset(&m_path, 0, sizeof(m_path));
@@ -210,7 +211,11 @@ void GSState::SetPrimHandlers()
 	m_fpGIFRegHandlerXYZ[P][2] = &GSState::GIFRegHandlerXYZ2<P, 0, auto_flush, index_swap>; \
 	m_fpGIFRegHandlerXYZ[P][3] = &GSState::GIFRegHandlerXYZ2<P, 1, auto_flush, index_swap>; \
 	m_fpGIFPackedRegHandlerSTQRGBAXYZF2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZF2<P, auto_flush, index_swap>; \
-	m_fpGIFPackedRegHandlerSTQRGBAXYZ2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZ2<P, auto_flush, index_swap>;
+	m_fpGIFPackedRegHandlerSTQRGBAXYZ2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZ2<P, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerRGBAXYZ[P][0] = &GSState::GIFPackedRegHandlerRGBAXYZ<P, false, true, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerRGBAXYZ[P][1] = &GSState::GIFPackedRegHandlerRGBAXYZ<P, false, false, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerRGBAXYZ[P][2] = &GSState::GIFPackedRegHandlerRGBAXYZ<P, true, true, auto_flush, index_swap>; \
+	m_fpGIFPackedRegHandlerRGBAXYZ[P][3] = &GSState::GIFPackedRegHandlerRGBAXYZ<P, true, false, auto_flush, index_swap>;
 
 	SetHandlerXYZ(GS_POINTLIST, true, false);
 	SetHandlerXYZ(GS_LINELIST, auto_flush, index_swap);
@@ -703,6 +708,62 @@ void GSState::GIFPackedRegHandlerSTQRGBAXYZ2(const GIFPackedReg* RESTRICT r, u32
 	m_q = r[-3].STQ.Q; // remember the last one, STQ outputs this to the temp Q each time
 }
 
+template <u32 prim, bool uv, bool fog, bool auto_flush, bool index_swap>
+void GSState::GIFPackedRegHandlerRGBAXYZ(const GIFPackedReg* RESTRICT r, u32 size)
+{
+	ASSERT(size > 0 && size % (uv ? 3 : 2) == 0);
+
+	CheckFlushes();
+
+	if (uv && GSConfig.UserHacks_WildHack)
+		m_isPackedUV_HackFlag = true; // see GIFPackedRegHandlerUV_Hack
+
+	// There's no STQ in the loop, so Q stays whatever the tag started with.
+	m_v.RGBAQ.Q = m_q;
+
+	const GIFPackedReg* RESTRICT r_end = r + size;
+
+	while (r < r_end)
+	{
+		if (uv)
+		{
+			const GSVector4i v = GSVector4i::loadl(r) & GSVector4i::x00003fff();
+
+			m_v.UV = (u32)GSVector4i::store(v.ps32(v));
+
+			r++;
+		}
+
+		const GSVector4i rgba = (GSVector4i::load<false>(&r[0]) & GSVector4i::x000000ff()).ps32().pu16();
+
+		m_v.RGBAQ.U32[0] = (u32)GSVector4i::store(rgba); // TODO: only store the last one
+
+		if (fog)
+		{
+			GSVector4i xy = GSVector4i::loadl(&r[1].U64[0]);
+			GSVector4i zf = GSVector4i::loadl(&r[1].U64[1]);
+			xy = xy.upl16(xy.srl<4>()).upl32(GSVector4i::load((int)m_v.UV));
+			zf = zf.srl32(4) & GSVector4i::x00ffffff().upl32(GSVector4i::x000000ff());
+
+			m_v.m[1] = xy.upl32(zf); // TODO: only store the last one
+
+			VertexKick<prim, auto_flush, index_swap>(r[1].XYZF2.Skip());
+		}
+		else
+		{
+			const GSVector4i xy = GSVector4i::loadl(&r[1].U64[0]);
+			const GSVector4i z = GSVector4i::loadl(&r[1].U64[1]);
+			const GSVector4i xyz = xy.upl16(xy.srl<4>()).upl32(z);
+
+			m_v.m[1] = xyz.upl64(GSVector4i::loadl(&m_v.UV)); // TODO: only store the last one
+
+			VertexKick<prim, auto_flush, index_swap>(r[1].XYZ2.Skip());
+		}
+
+		r += 2;
+	}
+}
+
 void GSState::GIFPackedRegHandlerNOP(const GIFPackedReg* RESTRICT r, u32 size)
 {
 }
@@ -822,6 +883,20 @@ void GSState::ApplyTEX0(GIFRegTEX0& TEX0)
 
 	GL_REG("Apply TEX0_%d = 0x%x_%x", i, TEX0.U32[1], TEX0.U32[0]);
 
+	// The palette may still be on its way to local memory. CSM2 can place it anywhere in the buffer.
+	if (TEX0.CLD != 0)
+	{
+		if (TEX0.CSM)
+			m_upload_thread.WaitForAll();
+		else
+			m_upload_thread.WaitForBlocks(TEX0.CBP, TEX0.CBP + 3);
+	}
+
+	// Targets covering the palette are only read back into local memory when the CLUT reloads, and draws to them
+	// aren't always tracked by the CLUT, so the palette can't be compared against local memory.
+	if (TEX0.CSM == 0 && MayOverlapTarget(TEX0.CBP, TEX0.CBP + 3))
+		m_mem.m_clut.ClearCompareEligibility();
+
 	// Even if TEX0 did not change, a new palette may have been uploaded and will overwrite the currently queued for drawing.
 	const bool wt = m_mem.m_clut.WriteTest(TEX0, m_env.TEXCLUT);
 
@@ -976,6 +1051,11 @@ void GSState::GIFRegHandlerTEX0(const GIFReg* RESTRICT r)
 	}
 
 	ApplyTEX0<i>(TEX0);
+
+	// Give the renderer a head start on the texture, the draw using it usually follows shortly.
+	// Not while transfers are in flight though, the prefetch thread would hash stale memory.
+	if (!m_upload_thread.IsBusy())
+		PrefetchTexture(m_env.CTXT[i].TEX0);
 }
 
 template <int i>
@@ -1500,6 +1580,9 @@ void GSState::FlushWrite()
 
 	InvalidateVideoMem(m_env.BITBLTBUF, r);
 
+	// Earlier transfers to the same pages have to land first.
+	m_upload_thread.WaitForRect(m_mem.GetOffset(m_env.BITBLTBUF.DBP, m_env.BITBLTBUF.DBW, m_env.BITBLTBUF.DPSM), r);
+
 	const GSLocalMemory::writeImage wi = GSLocalMemory::m_psm[m_env.BITBLTBUF.DPSM].wi;
 
 	wi(m_mem, m_tr.x, m_tr.y, &m_tr.buff[m_tr.start], len, m_env.BITBLTBUF, m_env.TRXPOS, m_env.TRXREG);
@@ -1510,6 +1593,47 @@ void GSState::FlushWrite()
 	s_transfer_n++;
 }
 
+// The following return true if the fields which differ between two register values can change the
+// outcome of a draw. Anything else can be merged into the pending draw instead of flushing it.
+static bool TestChangeAffectsDraw(const GIFRegTEST& prev, const GIFRegTEST& cur)
+{
+	u64 mask = 0x7FFFFull;
+	if (!prev.ATE || prev.ATST == ATST_ALWAYS)
+		mask &= ~0x3000ull; // AFAIL, nothing fails
+	if (!prev.ATE || prev.ATST == ATST_ALWAYS || prev.ATST == ATST_NEVER)
+		mask &= ~0xFF0ull; // AREF, nothing is compared
+	if (!prev.DATE)
+		mask &= ~0x8000ull; // DATM
+
+	return ((prev.U64 ^ cur.U64) & mask) != 0;
+}
+
+static bool AlphaChangeAffectsDraw(const GIFRegALPHA& prev, const GIFRegALPHA& cur)
+{
+	// FIX is only used as the C term.
+	const u64 mask = (prev.C == 2) ? 0xFF000000FFull : 0xFFull;
+	return ((prev.U64 ^ cur.U64) & mask) != 0;
+}
+
+static bool ClampChangeAffectsDraw(const GIFRegCLAMP& prev, const GIFRegCLAMP& cur)
+{
+	// The min/max values are only used by the region clamp/repeat modes.
+	u64 mask = 0xFull;
+	if (prev.WMS >= CLAMP_REGION_CLAMP)
+		mask |= 0xFFFFF0ull; // MINU MAXU
+	if (prev.WMT >= CLAMP_REGION_CLAMP)
+		mask |= 0xFFFFF000000ull; // MINV MAXV
+
+	return ((prev.U64 ^ cur.U64) & mask) != 0;
+}
+
+static bool TexaAffectsDraw(const GIFRegTEX0& TEX0)
+{
+	// Only 24/16-bit colours get expanded with TEXA, either directly or through the CLUT.
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
+	return ((psm.pal > 0) ? GSLocalMemory::m_psm[TEX0.CPSM].fmt : psm.fmt) > 0;
+}
+
 // This function decides if the context has changed in a way which warrants flushing the draw.
 inline bool GSState::TestDrawChanged()
 {
@@ -1533,17 +1657,26 @@ inline bool GSState::TestDrawChanged()
 			return false;
 	}
 
-	if ((m_dirty_gs_regs & ((1 << DIRTY_REG_TEST) | (1 << DIRTY_REG_SCISSOR) | (1 << DIRTY_REG_XYOFFSET) | (1 << DIRTY_REG_SCANMSK) | (1 << DIRTY_REG_DTHE))) || ((m_dirty_gs_regs & (1 << DIRTY_REG_DIMX)) && m_prev_env.DTHE.DTHE))
+	const int context = m_env.PRIM.CTXT;
+
+	if ((m_dirty_gs_regs & ((1 << DIRTY_REG_SCISSOR) | (1 << DIRTY_REG_XYOFFSET) | (1 << DIRTY_REG_SCANMSK) | (1 << DIRTY_REG_DTHE))) || ((m_dirty_gs_regs & (1 << DIRTY_REG_DIMX)) && m_prev_env.DTHE.DTHE))
 		return true;
 
-	if (m_env.PRIM.ABE && (m_dirty_gs_regs & ((1 << DIRTY_REG_ALPHA) | (1 << DIRTY_REG_PABE))))
+	if ((m_dirty_gs_regs & (1 << DIRTY_REG_TEST)) && TestChangeAffectsDraw(m_prev_env.CTXT[context].TEST, m_env.CTXT[context].TEST))
 		return true;
 
+	if (m_env.PRIM.ABE)
+	{
+		if (m_dirty_gs_regs & (1 << DIRTY_REG_PABE))
+			return true;
+
+		if ((m_dirty_gs_regs & (1 << DIRTY_REG_ALPHA)) && AlphaChangeAffectsDraw(m_prev_env.CTXT[context].ALPHA, m_env.CTXT[context].ALPHA))
+			return true;
+	}
+
 	if (m_env.PRIM.FGE && (m_dirty_gs_regs & (1 << DIRTY_REG_FOGCOL)))
 		return true;
 
-	const int context = m_env.PRIM.CTXT;
-
 	// If the frame is getting updated check the FRAME, otherwise, we can ignore it
 	if ((m_env.CTXT[context].TEST.ATST != ATST_NEVER) || !m_env.CTXT[context].TEST.ATE || (m_env.CTXT[context].TEST.AFAIL & 1) || m_env.CTXT[context].TEST.DATE)
 	{
@@ -1559,7 +1692,13 @@ inline bool GSState::TestDrawChanged()
 
 	if (m_env.PRIM.TME)
 	{
-		if (m_dirty_gs_regs & ((1 << DIRTY_REG_TEX0) | (1 << DIRTY_REG_TEX1) | (1 << DIRTY_REG_CLAMP) | (1 << DIRTY_REG_TEXA)))
+		if (m_dirty_gs_regs & ((1 << DIRTY_REG_TEX0) | (1 << DIRTY_REG_TEX1)))
+			return true;
+
+		if ((m_dirty_gs_regs & (1 << DIRTY_REG_CLAMP)) && ClampChangeAffectsDraw(m_prev_env.CTXT[context].CLAMP, m_env.CTXT[context].CLAMP))
+			return true;
+
+		if ((m_dirty_gs_regs & (1 << DIRTY_REG_TEXA)) && TexaAffectsDraw(m_env.CTXT[context].TEX0))
 			return true;
 
 		if(m_env.CTXT[context].TEX1.MXL > 0 && (m_dirty_gs_regs & ((1 << DIRTY_REG_MIPTBP1) | (1 << DIRTY_REG_MIPTBP2))))
@@ -1737,8 +1876,10 @@ void GSState::Write(const u8* mem, int len)
 				}
 			}
 		}
-		// Invalid the CLUT if it crosses paths.
-		m_mem.m_clut.InvalidateRange(write_start_bp, write_end_bp);
+		// Invalid the CLUT if it crosses paths. Transfers which arrive in one piece are written to local memory
+		// below (or queued, and waited for before the CLUT loads), so the CLUT can compare against it,
+		// buffered ones only land on FlushWrite().
+		m_mem.m_clut.InvalidateRange(write_start_bp, write_end_bp, false, len >= m_tr.total);
 
 		GSVector4i r;
 
@@ -1774,7 +1915,17 @@ void GSState::Write(const u8* mem, int len)
 			// received all data in one piece, no need to buffer it
 			InvalidateVideoMem(blit, r);
 
-			psm.wi(m_mem, m_tr.x, m_tr.y, mem, m_tr.total, blit, m_env.TRXPOS, m_env.TRXREG);
+			// Large transfers get swizzled on the upload thread, readers wait for the pages they need.
+			// The queue is in order, so only synchronous writes have to wait for earlier transfers.
+			if (m_tr.total >= GSUploadThread::MIN_ASYNC_SIZE && CanWriteAsync(blit, r))
+			{
+				m_upload_thread.Queue(blit, m_env.TRXPOS, m_env.TRXREG, r, mem, m_tr.total);
+			}
+			else
+			{
+				m_upload_thread.WaitForRect(m_mem.GetOffset(blit.DBP, blit.DBW, blit.DPSM), r);
+				psm.wi(m_mem, m_tr.x, m_tr.y, mem, m_tr.total, blit, m_env.TRXPOS, m_env.TRXREG);
+			}
 
 			m_tr.start = m_tr.end = m_tr.total;
 
@@ -1814,6 +1965,8 @@ void GSState::InitReadFIFO(u8* mem, int len)
 	if (m_tr.x == sx && m_tr.y == sy)
 		InvalidateLocalMem(m_env.BITBLTBUF, r);
 
+	m_upload_thread.WaitForAll();
+
 	// Read the image all in one go.
 	m_mem.ReadImageX(m_tr.x, m_tr.y, m_tr.buff, m_tr.total, m_env.BITBLTBUF, m_env.TRXPOS, m_env.TRXREG);
 
@@ -1864,6 +2017,8 @@ void GSState::Move()
 	// guitar hero copies the far end of the board to do a similar blend too
 	s_transfer_n++;
 
+	m_upload_thread.WaitForAll();
+
 	int sx = m_env.TRXPOS.SSAX;
 	int sy = m_env.TRXPOS.SSAY;
 	int dx = m_env.TRXPOS.DSAX;
@@ -2156,6 +2311,8 @@ void GSState::ReadLocalMemoryUnsync(u8* mem, int qwc, GIFRegBITBLTBUF BITBLTBUF,
 
 	const u16 bpp = GSLocalMemory::m_psm[BITBLTBUF.SPSM].trbpp;
 
+	m_upload_thread.WaitForAll();
+
 	GSTransferBuffer tb;
 
 	if(m_tr.end >= m_tr.total || m_tr.write == true)
@@ -2296,6 +2453,30 @@ void GSState::Transfer(const u8* mem, u32 size)
 
 								mem += total * sizeof(GIFPackedReg);
 
+								break;
+							case GIFPath::TYPE_RGBAXYZF2:
+								(this->*m_fpGIFPackedRegHandlersC[GIF_REG_RGBAXYZF2])((GIFPackedReg*)mem, total);
+
+								mem += total * sizeof(GIFPackedReg);
+
+								break;
+							case GIFPath::TYPE_RGBAXYZ2:
+								(this->*m_fpGIFPackedRegHandlersC[GIF_REG_RGBAXYZ2])((GIFPackedReg*)mem, total);
+
+								mem += total * sizeof(GIFPackedReg);
+
+								break;
+							case GIFPath::TYPE_UVRGBAXYZF2:
+								(this->*m_fpGIFPackedRegHandlersC[GIF_REG_UVRGBAXYZF2])((GIFPackedReg*)mem, total);
+
+								mem += total * sizeof(GIFPackedReg);
+
+								break;
+							case GIFPath::TYPE_UVRGBAXYZ2:
+								(this->*m_fpGIFPackedRegHandlersC[GIF_REG_UVRGBAXYZ2])((GIFPackedReg*)mem, total);
+
+								mem += total * sizeof(GIFPackedReg);
+
 								break;
 							default:
 								__assume(0);
@@ -2418,6 +2599,7 @@ int GSState::Freeze(freezeData* fd, bool sizeonly)
 		return -1;
 
 	Flush(GSFlushReason::SAVESTATE);
+	m_upload_thread.WaitForAll();
 
 	if (GSConfig.UserHacks_ReadTCOnClose)
 		ReadbackTextureCache();
@@ -2659,6 +2841,10 @@ void GSState::UpdateVertexKick()
 
 	m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZF2] = m_fpGIFPackedRegHandlerSTQRGBAXYZF2[prim];
 	m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZ2] = m_fpGIFPackedRegHandlerSTQRGBAXYZ2[prim];
+	m_fpGIFPackedRegHandlersC[GIF_REG_RGBAXYZF2] = m_fpGIFPackedRegHandlerRGBAXYZ[prim][0];
+	m_fpGIFPackedRegHandlersC[GIF_REG_RGBAXYZ2] = m_fpGIFPackedRegHandlerRGBAXYZ[prim][1];
+	m_fpGIFPackedRegHandlersC[GIF_REG_UVRGBAXYZF2] = m_fpGIFPackedRegHandlerRGBAXYZ[prim][2];
+	m_fpGIFPackedRegHandlersC[GIF_REG_UVRGBAXYZ2] = m_fpGIFPackedRegHandlerRGBAXYZ[prim][3];
 }
 
 void GSState::GrowVertexBuffer()
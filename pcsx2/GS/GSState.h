@@ -17,6 +17,7 @@
 
 #include "GS/GS.h"
 #include "GS/GSLocalMemory.h"
+#include "GS/GSUploadThread.h"
 #include "GS/GSDrawingContext.h"
 #include "GS/GSDrawingEnvironment.h"
 #include "GS/Renderers/Common/GSVertex.h"
@@ -64,12 +65,14 @@ private:
 
 	typedef void (GSState::*GIFPackedRegHandlerC)(const GIFPackedReg* RESTRICT r, u32 size);
 
-	GIFPackedRegHandlerC m_fpGIFPackedRegHandlersC[2] = {};
+	GIFPackedRegHandlerC m_fpGIFPackedRegHandlersC[6] = {};
 	GIFPackedRegHandlerC m_fpGIFPackedRegHandlerSTQRGBAXYZF2[8] = {};
 	GIFPackedRegHandlerC m_fpGIFPackedRegHandlerSTQRGBAXYZ2[8] = {};
+	GIFPackedRegHandlerC m_fpGIFPackedRegHandlerRGBAXYZ[8][4] = {};
 
 	template<u32 prim, bool auto_flush, bool index_swap> void GIFPackedRegHandlerSTQRGBAXYZF2(const GIFPackedReg* RESTRICT r, u32 size);
 	template<u32 prim, bool auto_flush, bool index_swap> void GIFPackedRegHandlerSTQRGBAXYZ2(const GIFPackedReg* RESTRICT r, u32 size);
+	template<u32 prim, bool uv, bool fog, bool auto_flush, bool index_swap> void GIFPackedRegHandlerRGBAXYZ(const GIFPackedReg* RESTRICT r, u32 size);
 	void GIFPackedRegHandlerNOP(const GIFPackedReg* RESTRICT r, u32 size);
 
 	template<int i> void ApplyTEX0(GIFRegTEX0& TEX0);
@@ -213,6 +216,7 @@ public:
 	const GIFRegPRIM* PRIM = nullptr;
 	GSPrivRegSet* m_regs = nullptr;
 	GSLocalMemory m_mem;
+	GSUploadThread m_upload_thread{m_mem};
 	GSDrawingEnvironment m_env = {};
 	GSDrawingEnvironment m_prev_env = {};
 	const GSDrawingEnvironment* m_draw_env = &m_env;
@@ -394,6 +398,14 @@ public:
 	virtual void ReadbackTextureCache();
 	virtual void InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r) {}
 	virtual void InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut = false) {}
+	virtual void PrefetchTexture(const GIFRegTEX0& TEX0) {}
+
+	/// Returns true if a transfer to the rectangle can be swizzled on the upload thread, which
+	/// requires that the renderer waits for it wherever it reads local memory.
+	virtual bool CanWriteAsync(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r) { return false; }
+
+	/// Returns true if a GPU target may hold newer data for the blocks in [start_bp, end_bp] than local memory.
+	virtual bool MayOverlapTarget(u32 start_bp, u32 end_bp) { return false; }
 
 	virtual void Move();
 
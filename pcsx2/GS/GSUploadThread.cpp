@@ -0,0 +1,160 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+#include "GS/GSUploadThread.h"
+#include "common/Threading.h"
+
+GSUploadThread::GSUploadThread(GSLocalMemory& mem)
+	: m_mem(mem)
+{
+}
+
+GSUploadThread::~GSUploadThread()
+{
+	StopThread();
+}
+
+void GSUploadThread::Queue(const GIFRegBITBLTBUF& BITBLTBUF, const GIFRegTRXPOS& TRXPOS, const GIFRegTRXREG& TRXREG,
+	const GSVector4i& r, const u8* data, int len)
+{
+	StartThread();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	// Don't let the thread fall too far behind, the data has to be held somewhere.
+	m_done_cv.wait(lock, [this]() { return m_uploads.size() < MAX_QUEUED_UPLOADS; });
+
+	Upload& upload = m_uploads.emplace_back();
+	upload.BITBLTBUF = BITBLTBUF;
+	upload.TRXPOS = TRXPOS;
+	upload.TRXREG = TRXREG;
+	if (!m_free_buffers.empty())
+	{
+		upload.data = std::move(m_free_buffers.back());
+		m_free_buffers.pop_back();
+	}
+	upload.data.assign(data, data + len);
+	upload.seq = ++m_queued_seq;
+	const u64 seq = upload.seq;
+	lock.unlock();
+
+	m_mem.GetOffset(BITBLTBUF.DBP, BITBLTBUF.DBW, BITBLTBUF.DPSM).loopPages(r, [this, seq](u32 page) {
+		m_page_seq[page] = seq;
+	});
+
+	m_work_cv.notify_one();
+}
+
+void GSUploadThread::WaitForRect(const GSOffset& off, const GSVector4i& r)
+{
+	if (!IsBusy())
+		return;
+
+	u64 seq = 0;
+	off.loopPages(r, [this, &seq](u32 page) { seq = std::max(seq, m_page_seq[page]); });
+	WaitForSeq(seq);
+}
+
+void GSUploadThread::WaitForBlocks(u32 start_bp, u32 end_bp)
+{
+	if (!IsBusy())
+		return;
+
+	const u32 start_page = start_bp / BLOCKS_PER_PAGE;
+	const u32 end_page = end_bp / BLOCKS_PER_PAGE;
+	if (end_page < start_page || (end_page - start_page) >= MAX_PAGES)
+	{
+		WaitForAll();
+		return;
+	}
+
+	u64 seq = 0;
+	for (u32 page = start_page; page <= end_page; page++)
+		seq = std::max(seq, m_page_seq[page % MAX_PAGES]);
+	WaitForSeq(seq);
+}
+
+void GSUploadThread::WaitForAll()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done_cv.wait(lock, [this]() { return m_completed_seq.load(std::memory_order_acquire) == m_queued_seq; });
+}
+
+void GSUploadThread::WaitForSeq(u64 seq)
+{
+	if (m_completed_seq.load(std::memory_order_acquire) >= seq)
+		return;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done_cv.wait(lock, [this, seq]() { return m_completed_seq.load(std::memory_order_acquire) >= seq; });
+}
+
+void GSUploadThread::StartThread()
+{
+	if (m_thread.joinable())
+		return;
+
+	m_thread_running = true;
+	m_thread = std::thread(&GSUploadThread::ThreadEntryPoint, this);
+}
+
+void GSUploadThread::StopThread()
+{
+	if (!m_thread.joinable())
+		return;
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_thread_running = false;
+		m_work_cv.notify_one();
+	}
+
+	m_thread.join();
+}
+
+void GSUploadThread::ThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("GS-Upload");
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (;;)
+	{
+		// Finish what's queued before exiting, the GS may still be waiting on it.
+		if (m_uploads.empty())
+		{
+			if (!m_thread_running)
+				break;
+
+			m_work_cv.wait(lock);
+			continue;
+		}
+
+		// The entry stays in the queue until it's written, so the GS thread counts it as in flight.
+		Upload& upload = m_uploads.front();
+		lock.unlock();
+
+		int x = upload.TRXPOS.DSAX;
+		int y = upload.TRXPOS.DSAY;
+		GSLocalMemory::m_psm[upload.BITBLTBUF.DPSM].wi(m_mem, x, y, upload.data.data(), static_cast<int>(upload.data.size()),
+			upload.BITBLTBUF, upload.TRXPOS, upload.TRXREG);
+
+		lock.lock();
+		m_completed_seq.store(upload.seq, std::memory_order_release);
+		m_free_buffers.push_back(std::move(upload.data));
+		m_uploads.pop_front();
+		m_done_cv.notify_all();
+	}
+}
@@ -0,0 +1,91 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "GS/GSLocalMemory.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Swizzles large host->local image transfers into local memory on a worker thread, so the GS thread
+/// can carry on with the packets that follow. The pages each transfer writes are tagged with its
+/// sequence number; anything which reads (or writes) local memory outside of the transfers must first
+/// wait for the pages it touches through one of the WaitFor*() methods.
+class GSUploadThread
+{
+public:
+	/// Transfers smaller than this are swizzled in less time than it takes to hand them over.
+	static constexpr int MIN_ASYNC_SIZE = 64 * 1024;
+
+	explicit GSUploadThread(GSLocalMemory& mem);
+	~GSUploadThread();
+
+	/// Returns true if there are transfers which haven't reached local memory yet. GS thread only.
+	__fi bool IsBusy() const { return (m_completed_seq.load(std::memory_order_acquire) != m_queued_seq); }
+
+	/// Copies the data and queues it to be written to the rectangle of the destination buffer.
+	/// The caller is responsible for invalidating anything cached from the rectangle beforehand.
+	void Queue(const GIFRegBITBLTBUF& BITBLTBUF, const GIFRegTRXPOS& TRXPOS, const GIFRegTRXREG& TRXREG,
+		const GSVector4i& r, const u8* data, int len);
+
+	/// Waits for the transfers which write to any page covered by the rectangle.
+	void WaitForRect(const GSOffset& off, const GSVector4i& r);
+
+	/// Waits for the transfers which write to any page covering the blocks in [start_bp, end_bp].
+	void WaitForBlocks(u32 start_bp, u32 end_bp);
+
+	/// Waits for every queued transfer. Safe to call from outside the GS thread.
+	void WaitForAll();
+
+private:
+	/// Maximum number of transfers in flight, before the GS thread blocks on the oldest.
+	static constexpr size_t MAX_QUEUED_UPLOADS = 8;
+
+	struct Upload
+	{
+		GIFRegBITBLTBUF BITBLTBUF;
+		GIFRegTRXPOS TRXPOS;
+		GIFRegTRXREG TRXREG;
+		std::vector<u8> data;
+		u64 seq;
+	};
+
+	void StartThread();
+	void StopThread();
+	void ThreadEntryPoint();
+
+	void WaitForSeq(u64 seq);
+
+	GSLocalMemory& m_mem;
+
+	std::thread m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_work_cv;
+	std::condition_variable m_done_cv;
+	std::deque<Upload> m_uploads;
+	std::vector<std::vector<u8>> m_free_buffers;
+	bool m_thread_running = false;
+
+	/// Sequence number of the last transfer written to each page, only touched by the GS thread.
+	std::array<u64, MAX_PAGES> m_page_seq = {};
+	u64 m_queued_seq = 0;
+	std::atomic<u64> m_completed_seq{0};
+};
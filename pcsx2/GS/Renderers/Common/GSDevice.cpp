@@ -22,6 +22,7 @@
 
 #include "common/BitUtils.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 
 #include "imgui.h"
 
@@ -204,6 +205,7 @@ void GSDevice::Destroy()
 
 	ClearCurrent();
 	PurgePool();
+	m_pipeline_journal.Close();
 }
 
 bool GSDevice::AcquireWindow(bool recreate_window)
@@ -429,6 +431,33 @@ void GSDevice::PurgePool()
 	m_pool_memory_usage = 0;
 }
 
+void GSDevice::OpenPipelineJournal(u32 crc)
+{
+	m_pipeline_journal.Close();
+
+	// Nothing to key the journal on for the BIOS or unknown discs.
+	const u32 key_size = GetPipelineJournalKeySize();
+	if (crc == 0 || key_size == 0 || GSConfig.DisableShaderCache)
+		return;
+
+	m_pipeline_journal.Open(RenderAPIToString(GetRenderAPI()), crc, key_size);
+}
+
+void GSDevice::PrecompilePipelines(float time_limit_ms)
+{
+	if (!m_pipeline_journal.HasPending())
+		return;
+
+	// Spread over several frames, so booting doesn't stall for the whole lot.
+	Common::Timer timer;
+	while (const void* key = m_pipeline_journal.GetNextPending())
+	{
+		PrecompilePipeline(key);
+		if (timer.GetTimeMilliseconds() >= time_limit_ms)
+			break;
+	}
+}
+
 GSTexture* GSDevice::CreateRenderTarget(int w, int h, GSTexture::Format format, bool clear)
 {
 	return FetchSurface(GSTexture::Type::RenderTarget, w, h, 1, format, clear, true);
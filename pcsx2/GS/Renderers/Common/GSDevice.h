@@ -19,6 +19,7 @@
 #include "common/WindowInfo.h"
 #include "GS/GS.h"
 #include "GS/Renderers/Common/GSFastList.h"
+#include "GS/Renderers/Common/GSPipelineJournal.h"
 #include "GS/Renderers/Common/GSTexture.h"
 #include "GS/Renderers/Common/GSVertex.h"
 #include "GS/GSAlignedClass.h"
@@ -794,9 +795,16 @@ protected:
 	unsigned int m_frame = 0; // for ageing the pool
 	bool m_rbswapped = false;
 	FeatureSupport m_features;
+	GSPipelineJournal m_pipeline_journal;
 
 	bool AcquireWindow(bool recreate_window);
 
+	/// Size of the draw pipeline key which is journaled, or zero if the backend doesn't journal pipelines.
+	virtual u32 GetPipelineJournalKeySize() const { return 0; }
+
+	/// Creates the draw pipeline for a journaled key, if it doesn't already exist.
+	virtual void PrecompilePipeline(const void* key) {}
+
 	virtual GSTexture* CreateSurface(GSTexture::Type type, int width, int height, int levels, GSTexture::Format format) = 0;
 	GSTexture* FetchSurface(GSTexture::Type type, int width, int height, int levels, GSTexture::Format format, bool clear, bool prefer_reuse);
 
@@ -947,6 +955,12 @@ public:
 	void AgePool();
 	void PurgePool();
 
+	/// Switches the draw pipeline journal to the specified game, queueing its pipelines for precompilation.
+	void OpenPipelineJournal(u32 crc);
+
+	/// Compiles pipelines from the journal until the time limit is exceeded.
+	void PrecompilePipelines(float time_limit_ms);
+
 	__fi static constexpr bool IsDualSourceBlendFactor(u8 factor)
 	{
 		return (factor == SRC1_ALPHA || factor == INV_SRC1_ALPHA || factor == SRC1_COLOR
@@ -0,0 +1,163 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+#include "GS/Renderers/Common/GSPipelineJournal.h"
+#include "Config.h"
+#include "ShaderCacheVersion.h"
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/StringUtil.h"
+
+#pragma pack(push, 4)
+struct PipelineJournalHeader
+{
+	u32 magic;
+	u32 version;
+	u32 key_size;
+};
+#pragma pack(pop)
+
+static constexpr u32 PIPELINE_JOURNAL_MAGIC = 0x4C4A5350; // PSJL
+
+GSPipelineJournal::GSPipelineJournal() = default;
+
+GSPipelineJournal::~GSPipelineJournal()
+{
+	Close();
+}
+
+std::string GSPipelineJournal::GetFileName(const char* api_name, u32 crc)
+{
+	return Path::Combine(EmuFolders::Cache, StringUtil::StdStringFromFormat("%s_pipelines_%08X.bin", api_name, crc));
+}
+
+bool GSPipelineJournal::Open(const char* api_name, u32 crc, u32 key_size)
+{
+	Close();
+
+	m_key_size = key_size;
+
+	const std::string filename = GetFileName(api_name, crc);
+	if (ReadExisting(filename))
+		return true;
+
+	return CreateNew(filename);
+}
+
+void GSPipelineJournal::Close()
+{
+	if (m_file)
+	{
+		std::fclose(m_file);
+		m_file = nullptr;
+	}
+
+	m_pending = {};
+	m_pending_pos = 0;
+	m_known_keys.clear();
+}
+
+bool GSPipelineJournal::ReadExisting(const std::string& filename)
+{
+	std::FILE* fp = FileSystem::OpenCFile(filename.c_str(), "r+b");
+	if (!fp)
+		return false;
+
+	PipelineJournalHeader header;
+	if (std::fread(&header, sizeof(header), 1, fp) != 1 || header.magic != PIPELINE_JOURNAL_MAGIC ||
+		header.version != SHADER_CACHE_VERSION || header.key_size != m_key_size)
+	{
+		Console.Warning("Discarding out of date pipeline journal '%s'", filename.c_str());
+		std::fclose(fp);
+		return false;
+	}
+
+	// A torn record from a crash is just dropped, and overwritten by the next one.
+	const s64 size = FileSystem::FSize64(fp);
+	const size_t count = (size > static_cast<s64>(sizeof(header))) ?
+		static_cast<size_t>((size - sizeof(header)) / m_key_size) : 0;
+	m_pending.resize(count * m_key_size);
+	if (count > 0 && std::fread(m_pending.data(), m_key_size, count, fp) != count)
+	{
+		Console.Error("Failed to read pipeline journal '%s'", filename.c_str());
+		std::fclose(fp);
+		m_pending = {};
+		return false;
+	}
+
+	for (size_t i = 0; i < count; i++)
+		m_known_keys.emplace(reinterpret_cast<const char*>(&m_pending[i * m_key_size]), m_key_size);
+
+	if (FileSystem::FSeek64(fp, sizeof(header) + count * m_key_size, SEEK_SET) != 0)
+	{
+		std::fclose(fp);
+		m_pending = {};
+		m_known_keys.clear();
+		return false;
+	}
+
+	Console.WriteLn("Read %zu pipelines from '%s'", count, filename.c_str());
+	m_file = fp;
+	return true;
+}
+
+bool GSPipelineJournal::CreateNew(const std::string& filename)
+{
+	m_file = FileSystem::OpenCFile(filename.c_str(), "wb");
+	if (!m_file)
+	{
+		Console.Error("Failed to open pipeline journal '%s' for writing", filename.c_str());
+		return false;
+	}
+
+	const PipelineJournalHeader header = {PIPELINE_JOURNAL_MAGIC, SHADER_CACHE_VERSION, m_key_size};
+	if (std::fwrite(&header, sizeof(header), 1, m_file) != 1 || std::fflush(m_file) != 0)
+	{
+		Console.Error("Failed to write header to pipeline journal '%s'", filename.c_str());
+		std::fclose(m_file);
+		m_file = nullptr;
+		FileSystem::DeleteFilePath(filename.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+void GSPipelineJournal::Record(const void* key)
+{
+	if (!m_file || !m_known_keys.emplace(static_cast<const char*>(key), m_key_size).second)
+		return;
+
+	if (std::fwrite(key, m_key_size, 1, m_file) != 1 || std::fflush(m_file) != 0)
+	{
+		Console.Error("Failed to write to pipeline journal, closing");
+		Close();
+	}
+}
+
+const void* GSPipelineJournal::GetNextPending()
+{
+	if (!HasPending())
+		return nullptr;
+
+	const void* key = &m_pending[m_pending_pos];
+	m_pending_pos += m_key_size;
+	if (!HasPending())
+		Console.WriteLn("Precompiled %zu pipelines from journal", m_pending.size() / m_key_size);
+
+	return key;
+}
@@ -0,0 +1,61 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+
+#include <cstdio>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/// Per-game list of the draw pipeline selectors a renderer has needed, so they can be
+/// compiled up front on the next boot instead of stalling the first draw which uses them.
+/// Keys are opaque fixed-size blobs, the backend decides what goes in them.
+class GSPipelineJournal
+{
+public:
+	GSPipelineJournal();
+	~GSPipelineJournal();
+
+	__fi bool IsOpen() const { return (m_file != nullptr); }
+	__fi bool HasPending() const { return (m_pending_pos < m_pending.size()); }
+
+	/// Opens (or creates) the journal for the specified game. Keys recorded in a previous
+	/// session become pending, and are handed out through GetNextPending().
+	bool Open(const char* api_name, u32 crc, u32 key_size);
+	void Close();
+
+	/// Appends a key to the journal, unless it's already in there.
+	void Record(const void* key);
+
+	/// Returns the next key from the previous session, or nullptr when there's none left.
+	const void* GetNextPending();
+
+private:
+	static std::string GetFileName(const char* api_name, u32 crc);
+
+	bool ReadExisting(const std::string& filename);
+	bool CreateNew(const std::string& filename);
+
+	std::FILE* m_file = nullptr;
+	u32 m_key_size = 0;
+
+	std::vector<u8> m_pending;
+	size_t m_pending_pos = 0;
+
+	std::unordered_set<std::string> m_known_keys;
+};
@@ -17,6 +17,10 @@
 #include "GSVertexTrace.h"
 #include "GS/GSUtil.h"
 #include "GS/GSState.h"
+#include "GS/GSThread_CXX11.h"
+#include "common/StringUtil.h"
+
+#include <array>
 
 GSVertexTrace::GSVertexTrace(const GSState* state, bool provoking_vertex_first)
 	: m_state(state)
@@ -24,6 +28,64 @@ GSVertexTrace::GSVertexTrace(const GSState* state, bool provoking_vertex_first)
 	MULTI_ISA_SELECT(GSVertexTracePopulateFunctions)(*this, provoking_vertex_first);
 }
 
+GSVertexTrace::~GSVertexTrace() = default;
+
+bool GSVertexTrace::CreateWorkers()
+{
+	if (m_workers_created)
+		return !m_workers.empty();
+
+	m_workers_created = true;
+
+	// Leave a core for the EE and one for the GS thread itself.
+	const int workers = std::min<int>(MAX_WORKERS, static_cast<int>(std::thread::hardware_concurrency()) - 2);
+	for (int i = 0; i < workers; i++)
+	{
+		m_workers.push_back(std::make_unique<FindMinMaxWorker>(
+			[i]() { Threading::SetNameOfCurrentThread(StringUtil::StdStringFromFormat("GS-VT-%d", i).c_str()); },
+			[this](FindMinMaxJob& job) { job.fmm(*this, job.vertex, job.index, job.count, *job.min, *job.max); },
+			std::function<void()>()));
+	}
+
+	return !m_workers.empty();
+}
+
+void GSVertexTrace::FindMinMax(FindMinMaxPtr fmm, const void* vertex, const u16* index, int count)
+{
+	// The software renderer's own workers are busy rasterizing the previous draw, don't fight them for cores.
+	if (count < PARALLEL_MIN_INDICES || !GSConfig.UseHardwareRenderer() || !CreateWorkers())
+	{
+		fmm(*this, vertex, index, count, m_min, m_max);
+		return;
+	}
+
+	// Chunks have to hold whole primitives, and whole pairs of them for the flat shaded triangle loop.
+	const int chunks = std::min<int>(static_cast<int>(m_workers.size()) + 1, count / (PARALLEL_MIN_INDICES / 2));
+	const int chunk_size = ((count + chunks - 1) / chunks + 5) / 6 * 6;
+
+	std::array<Vertex, MAX_WORKERS> min, max;
+	int queued = 0;
+	for (int start = chunk_size; start < count; start += chunk_size, queued++)
+	{
+		m_workers[queued]->Push(
+			{fmm, vertex, index + start, std::min(chunk_size, count - start), &min[queued], &max[queued]});
+	}
+
+	fmm(*this, vertex, index, std::min(chunk_size, count), m_min, m_max);
+
+	for (int i = 0; i < queued; i++)
+	{
+		m_workers[i]->Wait();
+
+		m_min.c = m_min.c.min_i32(min[i].c);
+		m_max.c = m_max.c.max_i32(max[i].c);
+		m_min.p = m_min.p.min(min[i].p);
+		m_max.p = m_max.p.max(max[i].p);
+		m_min.t = m_min.t.min(min[i].t);
+		m_max.t = m_max.t.max(max[i].t);
+	}
+}
+
 void GSVertexTrace::Update(const void* vertex, const u16* index, int v_count, int i_count, GS_PRIM_CLASS primclass)
 {
 	if (i_count == 0)
@@ -36,7 +98,7 @@ void GSVertexTrace::Update(const void* vertex, const u16* index, int v_count, in
 	u32 fst = m_state->PRIM->FST;
 	u32 color = !(m_state->PRIM->TME && m_state->m_context->TEX0.TFX == TFX_DECAL && m_state->m_context->TEX0.TCC);
 
-	m_fmm[color][fst][tme][iip][primclass](*this, vertex, index, i_count);
+	FindMinMax(m_fmm[color][fst][tme][iip][primclass], vertex, index, i_count);
 
 	// Potential float overflow detected. Better uses the slower division instead
 	// Note: If Q is too big, 1/Q will end up as 0. 1e30 is a random number
@@ -23,9 +23,15 @@
 #include "GS/Renderers/HW/GSVertexHW.h"
 #include "GSFunctionMap.h"
 
+#include <memory>
+#include <vector>
+
 class GSState;
 class GSVertexTrace;
 
+template <class T, int CAPACITY>
+class GSJobQueue;
+
 MULTI_ISA_DEF(class GSVertexTraceFMM;)
 MULTI_ISA_DEF(void GSVertexTracePopulateFunctions(GSVertexTrace& vt, bool provoking_vertex_first);)
 
@@ -47,12 +53,34 @@ public:
 	bool m_accurate_stq = false;
 
 protected:
+	/// Draws with at least this many indices are split across worker threads.
+	static constexpr int PARALLEL_MIN_INDICES = 32768;
+	static constexpr int MAX_WORKERS = 3;
+
 	const GSState* m_state;
 
-	typedef void (*FindMinMaxPtr)(GSVertexTrace& vt, const void* vertex, const u16* index, int count);
+	typedef void (*FindMinMaxPtr)(const GSVertexTrace& vt, const void* vertex, const u16* index, int count, Vertex& min, Vertex& max);
 
 	FindMinMaxPtr m_fmm[2][2][2][2][4];
 
+	struct FindMinMaxJob
+	{
+		FindMinMaxPtr fmm;
+		const void* vertex;
+		const u16* index;
+		int count;
+		Vertex* min;
+		Vertex* max;
+	};
+
+	using FindMinMaxWorker = GSJobQueue<FindMinMaxJob, 4>;
+
+	std::vector<std::unique_ptr<FindMinMaxWorker>> m_workers;
+	bool m_workers_created = false;
+
+	bool CreateWorkers();
+	void FindMinMax(FindMinMaxPtr fmm, const void* vertex, const u16* index, int count);
+
 public:
 	GS_PRIM_CLASS m_primclass = GS_INVALID_CLASS;
 
@@ -76,6 +104,7 @@ public:
 
 public:
 	GSVertexTrace(const GSState* state, bool provoking_vertex_first);
+	~GSVertexTrace();
 
 	void Update(const void* vertex, const u16* index, int v_count, int i_count, GS_PRIM_CLASS primclass);
 
@@ -22,7 +22,8 @@ class CURRENT_ISA::GSVertexTraceFMM
 	static constexpr GSVector4 s_minmax = GSVector4::cxpr(FLT_MAX, -FLT_MAX, 0.f, 0.f);
 
 	template <GS_PRIM_CLASS primclass, u32 iip, u32 tme, u32 fst, u32 color, bool flat_swapped>
-	static void FindMinMax(GSVertexTrace& vt, const void* vertex, const u16* index, int count);
+	static void FindMinMax(const GSVertexTrace& vt, const void* vertex, const u16* index, int count,
+		GSVertexTrace::Vertex& out_min, GSVertexTrace::Vertex& out_max);
 
 	template <GS_PRIM_CLASS primclass, u32 iip, u32 tme, u32 fst, u32 color>
 	static constexpr GSVertexTrace::FindMinMaxPtr GetFMM(bool provoking_vertex_first);
@@ -76,7 +77,8 @@ void GSVertexTraceFMM::Populate(GSVertexTrace& vt, bool provoking_vertex_first)
 }
 
 template <GS_PRIM_CLASS primclass, u32 iip, u32 tme, u32 fst, u32 color, bool flat_swapped>
-void GSVertexTraceFMM::FindMinMax(GSVertexTrace& vt, const void* vertex, const u16* index, int count)
+void GSVertexTraceFMM::FindMinMax(const GSVertexTrace& vt, const void* vertex, const u16* index, int count,
+	GSVertexTrace::Vertex& out_min, GSVertexTrace::Vertex& out_max)
 {
 	const GSDrawingContext* context = vt.m_state->m_context;
 
@@ -238,12 +240,12 @@ void GSVertexTraceFMM::FindMinMax(GSVertexTrace& vt, const void* vertex, const u
 	GSVector4 o(context->XYOFFSET);
 	GSVector4 s(1.0f / 16, 1.0f / 16, 2.0f, 1.0f);
 
-	vt.m_min.p = (GSVector4(pmin) - o) * s;
-	vt.m_max.p = (GSVector4(pmax) - o) * s;
+	out_min.p = (GSVector4(pmin) - o) * s;
+	out_max.p = (GSVector4(pmax) - o) * s;
 
 	// Fix signed int conversion
-	vt.m_min.p = vt.m_min.p.insert32<0, 2>(GSVector4::load((float)(u32)pmin.extract32<2>()));
-	vt.m_max.p = vt.m_max.p.insert32<0, 2>(GSVector4::load((float)(u32)pmax.extract32<2>()));
+	out_min.p = out_min.p.insert32<0, 2>(GSVector4::load((float)(u32)pmin.extract32<2>()));
+	out_max.p = out_max.p.insert32<0, 2>(GSVector4::load((float)(u32)pmax.extract32<2>()));
 
 	if (tme)
 	{
@@ -256,23 +258,23 @@ void GSVertexTraceFMM::FindMinMax(GSVertexTrace& vt, const void* vertex, const u
 			s = GSVector4(1 << context->TEX0.TW, 1 << context->TEX0.TH, 1, 1);
 		}
 
-		vt.m_min.t = tmin * s;
-		vt.m_max.t = tmax * s;
+		out_min.t = tmin * s;
+		out_max.t = tmax * s;
 	}
 	else
 	{
-		vt.m_min.t = GSVector4::zero();
-		vt.m_max.t = GSVector4::zero();
+		out_min.t = GSVector4::zero();
+		out_max.t = GSVector4::zero();
 	}
 
 	if (color)
 	{
-		vt.m_min.c = cmin.u8to32();
-		vt.m_max.c = cmax.u8to32();
+		out_min.c = cmin.u8to32();
+		out_max.c = cmax.u8to32();
 	}
 	else
 	{
-		vt.m_min.c = GSVector4i::zero();
-		vt.m_max.c = GSVector4i::zero();
+		out_min.c = GSVector4i::zero();
+		out_max.c = GSVector4i::zero();
 	}
 }
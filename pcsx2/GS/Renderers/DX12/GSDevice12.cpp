@@ -2899,9 +2899,24 @@ const ID3D12PipelineState* GSDevice12::GetTFXPipeline(const PipelineSelector& p)
 
 	ComPtr<ID3D12PipelineState> pipeline(CreateTFXPipeline(p));
 	it = m_tfx_pipelines.emplace(p, std::move(pipeline)).first;
+	if (it->second)
+		m_pipeline_journal.Record(&p);
+
 	return it->second.get();
 }
 
+u32 GSDevice12::GetPipelineJournalKeySize() const
+{
+	return sizeof(PipelineSelector);
+}
+
+void GSDevice12::PrecompilePipeline(const void* key)
+{
+	PipelineSelector p;
+	std::memcpy(&p, key, sizeof(p));
+	GetTFXPipeline(p);
+}
+
 bool GSDevice12::BindDrawPipeline(const PipelineSelector& p)
 {
 	const ID3D12PipelineState* pipeline = GetTFXPipeline(p);
@@ -868,6 +868,8 @@ bool GSHwHack::OI_PointListPalette(GSRendererHW& r, GSTexture* rt, GSTexture* ds
 		const GSVertex* RESTRICT v = r.m_vertex.buff;
 		const int ox(r.m_context->XYOFFSET.OFX);
 		const int oy(r.m_context->XYOFFSET.OFY);
+		g_texture_cache->InvalidateAllLocalMemHashes();
+		r.m_upload_thread.WaitForAll();
 		for (size_t i = 0; i < n_vertices; ++i)
 		{
 			const GSVertex& vi = v[i];
@@ -81,6 +81,7 @@ void GSRendererHW::SetGameCRC(u32 crc)
 	GSRenderer::SetGameCRC(crc);
 
 	GSTextureReplacements::GameChanged();
+	g_gs_device->OpenPipelineJournal(crc);
 }
 
 bool GSRendererHW::CanUpscale()
@@ -113,6 +114,9 @@ void GSRendererHW::UpdateSettings(const Pcsx2Config::GSOptions& old_config)
 
 void GSRendererHW::VSync(u32 field, bool registers_written, bool idle_frame)
 {
+	// Nothing should still be in flight by now, but the frame can be presented from local memory.
+	m_upload_thread.WaitForAll();
+
 	if (GSConfig.LoadTextureReplacements)
 		GSTextureReplacements::ProcessAsyncLoadedTextures();
 
@@ -159,6 +163,9 @@ void GSRendererHW::VSync(u32 field, bool registers_written, bool idle_frame)
 	m_skip = 0;
 	m_skip_offset = 0;
 
+	// Work through pipelines the game used last time, a few at a time, before it asks for them.
+	g_gs_device->PrecompilePipelines(PIPELINE_PRECOMPILE_TIME_PER_FRAME);
+
 	GSRenderer::VSync(field, registers_written, idle_frame);
 }
 
@@ -1157,6 +1164,9 @@ void GSRendererHW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 {
 	// printf("[%d] InvalidateVideoMem %d,%d - %d,%d %05x (%d)\n", static_cast<int>(g_perfmon.GetFrame()), r.left, r.top, r.right, r.bottom, static_cast<int>(BITBLTBUF.DBP), static_cast<int>(BITBLTBUF.DPSM));
 
+	// Local memory is about to be written by the transfer.
+	g_texture_cache->InvalidateLocalMemHashes(m_mem.GetOffset(BITBLTBUF.DBP, BITBLTBUF.DBW, BITBLTBUF.DPSM), r);
+
 	// This is gross, but if the EE write loops, we need to split it on the 2048 border.
 	GSVector4i rect = r;
 	bool loop_h = false;
@@ -1220,8 +1230,33 @@ void GSRendererHW::InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 	}
 }
 
+void GSRendererHW::PrefetchTexture(const GIFRegTEX0& TEX0)
+{
+	g_texture_cache->PrefetchTexture(TEX0, m_env.TEXA);
+}
+
+bool GSRendererHW::CanWriteAsync(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r)
+{
+	// Wrapping transfers get split up on invalidation, not worth the trouble.
+	if (r.z > 2048 || r.w > 2048)
+		return false;
+
+	// Targets get refreshed from local memory in too many places, so only plain texture uploads go async.
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[BITBLTBUF.DPSM];
+	const u32 start_bp = psm.info.bn(r.x, r.y, BITBLTBUF.DBP, BITBLTBUF.DBW);
+	const u32 end_bp = psm.info.bn(r.z - 1, r.w - 1, BITBLTBUF.DBP, BITBLTBUF.DBW);
+	return !g_texture_cache->MayOverlapTarget(start_bp, end_bp);
+}
+
+bool GSRendererHW::MayOverlapTarget(u32 start_bp, u32 end_bp)
+{
+	return g_texture_cache->MayOverlapTarget(start_bp, end_bp);
+}
+
 void GSRendererHW::Move()
 {
+	m_upload_thread.WaitForAll();
+
 	if (m_mv && m_mv(*this))
 	{
 		// Handled by HW hack.
@@ -1266,6 +1301,8 @@ float GSRendererHW::alpha1(int L, int X0, int X1)
 
 void GSRendererHW::SwSpriteRender()
 {
+	m_upload_thread.WaitForAll();
+
 	// Supported drawing attributes
 	ASSERT(PRIM->PRIM == GS_TRIANGLESTRIP || PRIM->PRIM == GS_SPRITE);
 	ASSERT(!PRIM->FGE); // No FOG
@@ -1335,6 +1372,8 @@ void GSRendererHW::SwSpriteRender()
 	const GSOffset spo = m_mem.GetOffset(m_context->TEX0.TBP0, m_context->TEX0.TBW, m_context->TEX0.PSM);
 	const GSOffset& dpo = m_context->offset.fb;
 
+	g_texture_cache->InvalidateLocalMemHashes(dpo, GSVector4i(dx, dy, dx + w, dy + h));
+
 	const bool alpha_blending_enabled = PRIM->ABE;
 
 	const GSVertex& v = m_index.tail > 0 ? m_vertex.buff[m_index.buff[m_index.tail - 1]] : GSVertex(); // Last vertex if any.
@@ -2393,10 +2432,14 @@ void GSRendererHW::Draw()
 					rt->m_valid_alpha_high = false;
 			}
 			rt->m_TEX0 = FRAME_TEX0;
+			g_texture_cache->UpdateTargetPages(rt);
 		}
 
 		if (ds && (!is_possible_mem_clear || ds->m_TEX0.PSM != ZBUF_TEX0.PSM))
+		{
 			ds->m_TEX0 = ZBUF_TEX0;
+			g_texture_cache->UpdateTargetPages(ds);
+		}
 	}
 	else if (!m_texture_shuffle)
 	{
@@ -5641,6 +5684,9 @@ void GSRendererHW::ClearGSLocalMemory(const GSOffset& off, const GSVector4i& r,
 	GL_INS("ClearGSLocalMemory(): %08X %d,%d => %d,%d @ BP %x BW %u %s", vert_color, r.x, r.y, r.z, r.w, off.bp(),
 		off.bw(), psm_str(off.psm()));
 
+	g_texture_cache->InvalidateLocalMemHashes(off, r);
+	m_upload_thread.WaitForRect(off, r);
+
 	const u32 psm = (off.psm() == PSMCT32 && m_cached_ctx.FRAME.FBMSK == 0xFF000000u) ? PSMCT24 : off.psm();
 	const int format = GSLocalMemory::m_psm[psm].fmt;
 
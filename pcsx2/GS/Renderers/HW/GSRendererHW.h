@@ -38,6 +38,7 @@ public:
 
 private:
 	static constexpr float SSR_UV_TOLERANCE = 1.0f;
+	static constexpr float PIPELINE_PRECOMPILE_TIME_PER_FRAME = 4.0f;
 
 	using GSC_Ptr = bool(*)(GSRendererHW& r, int& skip);	// GSC - Get Skip Count
 	using OI_Ptr = bool(*)(GSRendererHW& r, GSTexture* rt, GSTexture* ds, GSTextureCache::Source* t); // OI - Before draw
@@ -207,6 +208,9 @@ public:
 	GSTexture* GetFeedbackOutput(float& scale) override;
 	void InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r) override;
 	void InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut = false) override;
+	void PrefetchTexture(const GIFRegTEX0& TEX0) override;
+	bool CanWriteAsync(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r) override;
+	bool MayOverlapTarget(u32 start_bp, u32 end_bp) override;
 	void Move() override;
 	void Draw() override;
 
@@ -48,6 +48,8 @@ bool GSRendererHWFunctions::SwPrimRender(GSRendererHW& hw, bool invalidate_tc, b
 	const GSDrawingEnvironment& env = *hw.m_draw_env;
 	const GS_PRIM_CLASS primclass = vt.m_primclass;
 
+	g_texture_cache->InvalidateAllLocalMemHashes();
+
 	GSRasterizerData data;
 	GSScanlineGlobalData& gd = data.global;
 
@@ -84,6 +86,8 @@ bool GSRendererHWFunctions::SwPrimRender(GSRendererHW& hw, bool invalidate_tc, b
 	data.bbox = bbox;
 	data.frame = g_perfmon.GetFrame();
 
+	// Drawn straight into local memory, which has to be current.
+	hw.m_upload_thread.WaitForAll();
 	gd.vm = hw.m_mem.m_vm8;
 
 	gd.fbo = context->offset.fb;
@@ -24,6 +24,7 @@
 #include "GS/GSXXH.h"
 #include "common/BitUtils.h"
 #include "common/HashCombine.h"
+#include "common/ScopedGuard.h"
 
 #ifdef __APPLE__
 #include <stdlib.h>
@@ -38,6 +39,25 @@ static u8* s_unswizzle_buffer;
 /// List of candidates for purging when the hash cache gets too large.
 static std::vector<std::pair<GSTextureCache::HashCacheMap::iterator, s32>> s_hash_cache_purge_list;
 
+/// Waits for in-flight transfers to the pages a texture is read from. Mipmaps live at unrelated
+/// addresses, so those just wait for everything.
+static void WaitForTextureUploads(const GIFRegTEX0& TEX0, const GSTextureCache::SourceRegion& region, const GSVector2i* lod)
+{
+	GSUploadThread& uploads = g_gs_renderer->m_upload_thread;
+	if (!uploads.IsBusy())
+		return;
+
+	if (lod)
+	{
+		uploads.WaitForAll();
+		return;
+	}
+
+	const int tw = std::max(region.GetWidth(), 1 << TEX0.TW);
+	const int th = std::max(region.GetHeight(), 1 << TEX0.TH);
+	uploads.WaitForRect(g_gs_renderer->m_mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM), region.GetRect(tw, th));
+}
+
 GSTextureCache::GSTextureCache()
 {
 	// In theory 4MB is enough but 9MB is safer for overflow (8MB
@@ -51,6 +71,7 @@ GSTextureCache::GSTextureCache()
 
 GSTextureCache::~GSTextureCache()
 {
+	StopPrefetchThread();
 	RemoveAll();
 
 	s_hash_cache_purge_list = {};
@@ -62,12 +83,15 @@ void GSTextureCache::ReadbackAll()
 	for (int type = 0; type < 2; type++)
 	{
 		for (auto t : m_dst[type])
-			Read(t, t->m_drawn_since_read);
+			QueueRead(t, t->m_drawn_since_read);
 	}
+
+	FlushReadbacks();
 }
 
 void GSTextureCache::RemoveAll()
 {
+	InvalidateAllLocalMemHashes();
 	m_src.RemoveAll();
 
 	for (int type = 0; type < 2; type++)
@@ -76,6 +100,7 @@ void GSTextureCache::RemoveAll()
 			delete t;
 
 		m_dst[type].clear();
+		m_dst_pages[type].Clear();
 	}
 
 	for (auto it : m_hash_cache)
@@ -1486,6 +1511,7 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 			dst->m_32_bits_fmt = dst_match->m_32_bits_fmt;
 			dst->OffsetHack_modxy = dst_match->OffsetHack_modxy;
 			dst->m_end_block = dst_match->m_end_block; // If we're copying the size, we need to keep the end block.
+			UpdateTargetPages(dst);
 			dst->m_valid = dst_match->m_valid;
 			dst->m_valid_alpha_low = dst_match->m_valid_alpha_low && psm_s.trbpp != 24;
 			dst->m_valid_alpha_high = dst_match->m_valid_alpha_high && psm_s.trbpp != 24;
@@ -2206,6 +2232,9 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 
 	for (int type = 0; type < 2; type++)
 	{
+		if (!m_dst_pages[type].Overlaps(bp, std::max(bp, end_bp)))
+			continue;
+
 		auto& list = m_dst[type];
 		for (auto i = list.begin(); i != list.end();)
 		{
@@ -2661,6 +2690,9 @@ void GSTextureCache::InvalidateLocalMem(const GSOffset& off, const GSVector4i& r
 	const u32 read_start = GSLocalMemory::m_psm[psm].info.bn(r.x, r.y, bp, bw);
 	const u32 read_end = GSLocalMemory::m_psm[psm].info.bn(r.z - 1, r.w - 1, bp, bw);
 
+	// Downloads from every matching target are queued and waited on together when we leave.
+	ScopedGuard flush_readbacks([this]() { FlushReadbacks(); });
+
 	GL_CACHE("TC: InvalidateLocalMem off(0x%x, %u, %s) r(%d, %d => %d, %d)",
 		bp,
 		bw,
@@ -2777,7 +2809,7 @@ void GSTextureCache::InvalidateLocalMem(const GSOffset& off, const GSVector4i& r
 					if (t->m_TEX0.TBP0 == bp && !dirty_rect.rintersect(targetr).rempty())
 						t->Update();
 
-					Read(t, draw_rect);
+					QueueRead(t, draw_rect);
 
 					z_found = read_start >= t->m_TEX0.TBP0 && read_end <= t->m_end_block;
 
@@ -2950,7 +2982,7 @@ void GSTextureCache::InvalidateLocalMem(const GSOffset& off, const GSVector4i& r
 				if (exact_bp && !dirty_rect.rintersect(targetr).rempty())
 					t->Update();
 
-				Read(t, targetr);
+				QueueRead(t, targetr);
 
 				// Try to cut down how much we read next, if we can.
 				// Fatal Frame reads in vertical strips, SOCOM 2 does horizontal, so we can handle that below.
@@ -3323,7 +3355,11 @@ GSTextureCache::Target* GSTextureCache::GetExactTarget(u32 BP, u32 BW, int type,
 
 GSTextureCache::Target* GSTextureCache::GetTargetWithSharedBits(u32 BP, u32 PSM) const
 {
-	auto& rts = m_dst[GSLocalMemory::m_psm[PSM].depth ? DepthStencil : RenderTarget];
+	const int type = GSLocalMemory::m_psm[PSM].depth ? DepthStencil : RenderTarget;
+	if (!m_dst_pages[type].Overlaps(BP, BP))
+		return nullptr;
+
+	auto& rts = m_dst[type];
 	for (auto it = rts.begin(); it != rts.end(); ++it) // Iterate targets from MRU to LRU.
 	{
 		Target* t = *it;
@@ -3339,6 +3375,9 @@ GSTextureCache::Target* GSTextureCache::FindOverlappingTarget(u32 BP, u32 end_bp
 {
 	for (int i = 0; i < 2; i++)
 	{
+		if (!m_dst_pages[i].Overlaps(BP, end_bp))
+			continue;
+
 		for (Target* tgt : m_dst[i])
 		{
 			if (CheckOverlap(tgt->m_TEX0.TBP0, tgt->m_end_block, BP, end_bp))
@@ -3521,6 +3560,9 @@ void GSTextureCache::IncAge()
 
 	for (int type = 0; type < 2; type++)
 	{
+		// Rebuild the page map from scratch so removed and shrunk targets stop matching.
+		m_dst_pages[type].Clear();
+
 		auto& list = m_dst[type];
 		for (auto i = list.begin(); i != list.end();)
 		{
@@ -3536,6 +3578,7 @@ void GSTextureCache::IncAge()
 			}
 			else
 			{
+				m_dst_pages[type].Add(t);
 				++i;
 			}
 		}
@@ -3951,6 +3994,9 @@ GSTextureCache::Source* GSTextureCache::CreateMergedSource(GIFRegTEX0 TEX0, GIFR
 	const u32 end_block = GSLocalMemory::m_psm[TEX0.PSM].info.bn(tex_width - 1, tex_height - 1, TEX0.TBP0, TEX0.TBW);
 	GL_PUSH("Merging targets from %x through %x", TEX0.TBP0, end_block);
 
+	// Gaps between the targets are filled from local memory.
+	g_gs_renderer->m_upload_thread.WaitForBlocks(TEX0.TBP0, end_block);
+
 	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
 	const int page_width = psm.pgs.x;
 	const int page_height = psm.pgs.y;
@@ -4236,9 +4282,27 @@ GSTextureCache::HashCacheEntry* GSTextureCache::LookupHashCache(const GIFRegTEX0
 	if (!dump && !replace && !can_cache)
 		return nullptr;
 
+	WaitForTextureUploads(TEX0, region, lod);
+
 	// need the hash either for replacing, dumping or caching.
 	// if dumping/replacing is on, we compute the clut hash regardless, since replacements aren't indexed
-	HashCacheKey key{ HashCacheKey::Create(TEX0, TEXA, (dump || replace || !paltex) ? clut : nullptr, lod, region) };
+	// page hashes are only stable within a session, so they can't be used when textures get persisted
+	HashType base_hash;
+	bool has_base_hash = false;
+	if (!lod)
+	{
+		if (!dump && !replace && CanHashTexturePages(TEX0, region))
+		{
+			base_hash = HashTexturePages(TEX0);
+			has_base_hash = true;
+		}
+		else if (!region.HasEither())
+		{
+			has_base_hash = GetPrefetchedHash(TEX0, TEXA, &base_hash);
+		}
+	}
+	HashCacheKey key{ HashCacheKey::Create(TEX0, TEXA, (dump || replace || !paltex) ? clut : nullptr, lod, region,
+		has_base_hash ? &base_hash : nullptr) };
 
 	// handle dumping first, this is mostly isolated.
 	if (dump)
@@ -4458,6 +4522,7 @@ GSTextureCache::Target* GSTextureCache::Target::Create(GIFRegTEX0 TEX0, int w, i
 	g_texture_cache->m_target_memory_usage += t->m_texture->GetMemUsage();
 
 	g_texture_cache->m_dst[type].push_front(t);
+	g_texture_cache->m_dst_pages[type].Add(t);
 
 	return t;
 }
@@ -4534,17 +4599,22 @@ std::shared_ptr<GSTextureCache::Palette> GSTextureCache::LookupPaletteObject(con
 }
 
 void GSTextureCache::Read(Target* t, const GSVector4i& r)
+{
+	if (QueueRead(t, r))
+		FlushReadbacks();
+}
+
+bool GSTextureCache::QueueRead(Target* t, const GSVector4i& r)
 {
 	if ((!t->m_dirty.empty() && !t->m_dirty.GetTotalRect(t->m_TEX0, t->m_unscaled_size).rintersect(r).rempty())
 		|| r.width() == 0 || r.height() == 0)
-		return;
+		return false;
 
 	const GIFRegTEX0& TEX0 = t->m_TEX0;
 	const bool is_depth = (t->m_type == DepthStencil);
 
 	GSTexture::Format fmt;
 	ShaderConvert ps_shader;
-	std::unique_ptr<GSDownloadTexture>* dltex;
 	switch (TEX0.PSM)
 	{
 		case PSMCT32:
@@ -4557,13 +4627,11 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 			{
 				fmt = GSTexture::Format::UInt32;
 				ps_shader = ShaderConvert::FLOAT32_TO_32_BITS;
-				dltex = &m_uint32_download_texture;
 			}
 			else
 			{
 				fmt = GSTexture::Format::Color;
 				ps_shader = ShaderConvert::COPY;
-				dltex = &m_color_download_texture;
 			}
 		}
 		break;
@@ -4573,7 +4641,6 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 		{
 			fmt = GSTexture::Format::UInt16;
 			ps_shader = is_depth ? ShaderConvert::FLOAT32_TO_16_BITS : ShaderConvert::RGBA8_TO_16_BITS;
-			dltex = &m_uint16_download_texture;
 		}
 		break;
 
@@ -4582,7 +4649,6 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 		{
 			fmt = GSTexture::Format::UInt32;
 			ps_shader = ShaderConvert::FLOAT32_TO_32_BITS;
-			dltex = &m_uint32_download_texture;
 		}
 		break;
 
@@ -4591,12 +4657,11 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 		{
 			fmt = GSTexture::Format::UInt16;
 			ps_shader = ShaderConvert::FLOAT32_TO_16_BITS;
-			dltex = &m_uint16_download_texture;
 		}
 		break;
 
 		default:
-			return;
+			return false;
 	}
 
 	// Don't overwrite bits which aren't used in the target's format.
@@ -4605,7 +4670,7 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 	if (write_mask == 0)
 	{
 		DbgCon.Warning("Not reading back target %x PSM %s due to no write mask", TEX0.TBP0, psm_str(TEX0.PSM));
-		return;
+		return false;
 	}
 
 	GL_PERF("TC: Read Back Target: (0x%x)[fmt: 0x%x]. Size %dx%d", TEX0.TBP0, TEX0.PSM, r.width(), r.height());
@@ -4614,12 +4679,13 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 	const GSVector4i drc(0, 0, r.width(), r.height());
 	const bool direct_read = (t->m_type == RenderTarget && t->m_scale == 1.0f && ps_shader == ShaderConvert::COPY);
 
-	if (!PrepareDownloadTexture(drc.z, drc.w, fmt, dltex))
-		return;
+	std::unique_ptr<GSDownloadTexture> dltex = GetReadbackTexture(drc.z, drc.w, fmt);
+	if (!dltex)
+		return false;
 
 	if (direct_read)
 	{
-		dltex->get()->CopyFromTexture(drc, t->m_texture, r, 0, true);
+		dltex->CopyFromTexture(drc, t->m_texture, r, 0, true);
 	}
 	else
 	{
@@ -4628,46 +4694,97 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 		{
 			g_gs_device->StretchRect(t->m_texture, src, tmp, GSVector4(drc), ps_shader, false);
 			g_perfmon.Put(GSPerfMon::TextureCopies, 1);
-			dltex->get()->CopyFromTexture(drc, tmp, drc, 0, true);
+			dltex->CopyFromTexture(drc, tmp, drc, 0, true);
 			g_gs_device->Recycle(tmp);
 		}
 		else
 		{
 			Console.Error("Failed to allocate temporary %dx%d target for read.", drc.z, drc.w);
-			return;
+			RecycleReadbackTexture(std::move(dltex));
+			return false;
 		}
 	}
 
-	dltex->get()->Flush();
-	if (!dltex->get()->Map(drc))
-		return;
-
-	// Why does WritePixelNN() not take a const pointer?
-	const GSOffset off = g_gs_renderer->m_mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM);
-	u8* bits = const_cast<u8*>(dltex->get()->GetMapPointer());
-	const u32 pitch = dltex->get()->GetMapPitch();
+	m_pending_readbacks.push_back({std::move(dltex), TEX0, r, write_mask});
+	return true;
+}
 
-	switch (TEX0.PSM)
+void GSTextureCache::FlushReadbacks()
+{
+	// The first flush submits the copies for every queued download, the others only wait on their fences.
+	// Write back in queue order, so data from targets read later wins where they overlap.
+	for (PendingReadback& rb : m_pending_readbacks)
 	{
-		case PSMCT32:
-		case PSMZ32:
-		case PSMCT24:
-		case PSMZ24:
-			g_gs_renderer->m_mem.WritePixel32(bits, pitch, off, r, write_mask);
-			break;
-		case PSMCT16:
-		case PSMCT16S:
-		case PSMZ16:
-		case PSMZ16S:
-			g_gs_renderer->m_mem.WritePixel16(bits, pitch, off, r);
-			break;
+		GSDownloadTexture* dltex = rb.texture.get();
+		const GSVector4i drc(0, 0, rb.rect.width(), rb.rect.height());
 
-		default:
-			Console.Error("Unknown PSM %u on Read", TEX0.PSM);
-			break;
+		dltex->Flush();
+		if (dltex->Map(drc))
+		{
+			// Why does WritePixelNN() not take a const pointer?
+			const GSOffset off = g_gs_renderer->m_mem.GetOffset(rb.TEX0.TBP0, rb.TEX0.TBW, rb.TEX0.PSM);
+			InvalidateLocalMemHashes(off, rb.rect);
+			g_gs_renderer->m_upload_thread.WaitForRect(off, rb.rect);
+
+			u8* bits = const_cast<u8*>(dltex->GetMapPointer());
+			const u32 pitch = dltex->GetMapPitch();
+
+			switch (rb.TEX0.PSM)
+			{
+				case PSMCT32:
+				case PSMZ32:
+				case PSMCT24:
+				case PSMZ24:
+					g_gs_renderer->m_mem.WritePixel32(bits, pitch, off, rb.rect, rb.write_mask);
+					break;
+				case PSMCT16:
+				case PSMCT16S:
+				case PSMZ16:
+				case PSMZ16S:
+					g_gs_renderer->m_mem.WritePixel16(bits, pitch, off, rb.rect);
+					break;
+
+				default:
+					Console.Error("Unknown PSM %u on Read", rb.TEX0.PSM);
+					break;
+			}
+
+			dltex->Unmap();
+		}
+
+		RecycleReadbackTexture(std::move(rb.texture));
 	}
 
-	dltex->get()->Unmap();
+	m_pending_readbacks.clear();
+}
+
+std::unique_ptr<GSDownloadTexture> GSTextureCache::GetReadbackTexture(u32 width, u32 height, GSTexture::Format format)
+{
+	for (auto it = m_readback_textures.begin(); it != m_readback_textures.end(); ++it)
+	{
+		GSDownloadTexture* tex = it->get();
+		if (tex->GetFormat() == format && tex->GetWidth() >= width && tex->GetHeight() >= height)
+		{
+			std::unique_ptr<GSDownloadTexture> ret = std::move(*it);
+			m_readback_textures.erase(it);
+			return ret;
+		}
+	}
+
+	std::unique_ptr<GSDownloadTexture> tex = g_gs_device->CreateDownloadTexture(width, height, format);
+	if (!tex)
+		Console.WriteLn("Failed to create %ux%u download texture", width, height);
+
+	return tex;
+}
+
+void GSTextureCache::RecycleReadbackTexture(std::unique_ptr<GSDownloadTexture> tex)
+{
+	// Keep the most recently used ones, batches rarely touch more than a few targets.
+	if (m_readback_textures.size() >= MAX_READBACK_TEXTURES)
+		m_readback_textures.erase(m_readback_textures.begin());
+
+	m_readback_textures.push_back(std::move(tex));
 }
 
 void GSTextureCache::Read(Source* t, const GSVector4i& r)
@@ -4686,6 +4803,8 @@ void GSTextureCache::Read(Source* t, const GSVector4i& r)
 	if (m_color_download_texture->Map(drc))
 	{
 		const GSOffset off = g_gs_renderer->m_mem.GetOffset(t->m_TEX0.TBP0, t->m_TEX0.TBW, t->m_TEX0.PSM);
+		InvalidateLocalMemHashes(off, r);
+		g_gs_renderer->m_upload_thread.WaitForRect(off, r);
 		g_gs_renderer->m_mem.WritePixel32(
 			const_cast<u8*>(m_color_download_texture->GetMapPointer()), m_color_download_texture->GetMapPitch(), off, r);
 		m_color_download_texture->Unmap();
@@ -4967,6 +5086,8 @@ void GSTextureCache::Source::Flush(u32 count, int layer, const GSOffset& off)
 	{
 		const GSVector4i r(m_write.rect[i]);
 
+		g_gs_renderer->m_upload_thread.WaitForRect(off, r);
+
 		// if update rect lies to the left/above of the region rectangle, or extends past the texture bounds, we can't use a direct map
 		if (((r > tex_r).mask() & 0xff00) == 0 && ((tex_r > r).mask() & 0x00ff) == 0)
 		{
@@ -5004,7 +5125,13 @@ void GSTextureCache::Source::Flush(u32 count, int layer, const GSOffset& off)
 void GSTextureCache::Source::PreloadLevel(int level)
 {
 	// m_TEX0 is adjusted for mips (messy, should be changed).
-	const HashType hash = HashTexture(m_TEX0, m_TEXA, m_region);
+	WaitForTextureUploads(m_TEX0, m_region.AdjustForMipmap(level), nullptr);
+
+	HashType hash;
+	if (CanHashTexturePages(m_TEX0, m_region))
+		hash = g_texture_cache->HashTexturePages(m_TEX0);
+	else if (level != 0 || m_region.HasEither() || !g_texture_cache->GetPrefetchedHash(m_TEX0, m_TEXA, &hash))
+		hash = HashTexture(m_TEX0, m_TEXA, m_region);
 
 	// Layer is complete again, regardless of whether the hash matches or not (and we reupload).
 	const u8 layer_bit = static_cast<u8>(1) << level;
@@ -5093,6 +5220,9 @@ void GSTextureCache::Target::Update()
 	if (m_dirty.empty())
 		return;
 
+	// Local memory has to be current before it's uploaded into the target.
+	g_texture_cache->FlushReadbacks();
+
 	// No handling please
 	if (m_type == DepthStencil && GSConfig.UserHacks_DisableDepthSupport)
 	{
@@ -5141,6 +5271,8 @@ void GSTextureCache::Target::Update()
 		if (r.rempty())
 			continue;
 
+		g_gs_renderer->m_upload_thread.WaitForRect(off, r);
+
 		const GSVector4i t_r(r - t_offset);
 		if (mapped)
 		{
@@ -5263,6 +5395,7 @@ void GSTextureCache::Target::ResizeValidity(const GSVector4i& rect)
 		m_valid = m_valid.rintersect(rect);
 		m_drawn_since_read = m_drawn_since_read.rintersect(rect);
 		m_end_block = GSLocalMemory::GetEndBlockAddress(m_TEX0.TBP0, m_TEX0.TBW, m_TEX0.PSM, m_valid);
+		g_texture_cache->UpdateTargetPages(this);
 	}
 	// Else No valid size, so need to resize down.
 
@@ -5279,6 +5412,7 @@ void GSTextureCache::Target::UpdateValidity(const GSVector4i& rect, bool can_res
 			m_valid = m_valid.runion(rect);
 
 		m_end_block = GSLocalMemory::GetEndBlockAddress(m_TEX0.TBP0, m_TEX0.TBW, m_TEX0.PSM, m_valid);
+		g_texture_cache->UpdateTargetPages(this);
 	}
 	// GL_CACHE("UpdateValidity (0x%x->0x%x) from R:%d,%d Valid: %d,%d", m_TEX0.TBP0, m_end_block, rect.z, rect.w, m_valid.z, m_valid.w);
 }
@@ -5346,6 +5480,42 @@ bool GSTextureCache::Target::ResizeTexture(int new_unscaled_width, int new_unsca
 	return true;
 }
 
+// GSTextureCache::TargetPageMap
+
+void GSTextureCache::TargetPageMap::Add(const Target* t)
+{
+	const u32 start_page = t->m_TEX0.TBP0 / BLOCKS_PER_PAGE;
+	const u32 end_page = t->UnwrappedEndBlock() / BLOCKS_PER_PAGE;
+	if ((end_page - start_page) >= MAX_PAGES)
+	{
+		m_pages.fill(~static_cast<u64>(0));
+		return;
+	}
+
+	for (u32 page = start_page; page <= end_page; page++)
+	{
+		const u32 wrapped = page % MAX_PAGES;
+		m_pages[wrapped / 64] |= static_cast<u64>(1) << (wrapped % 64);
+	}
+}
+
+bool GSTextureCache::TargetPageMap::Overlaps(u32 start_bp, u32 end_bp) const
+{
+	const u32 start_page = start_bp / BLOCKS_PER_PAGE;
+	const u32 end_page = end_bp / BLOCKS_PER_PAGE;
+	if (end_page < start_page || (end_page - start_page) >= MAX_PAGES)
+		return true;
+
+	for (u32 page = start_page; page <= end_page; page++)
+	{
+		const u32 wrapped = page % MAX_PAGES;
+		if (m_pages[wrapped / 64] & (static_cast<u64>(1) << (wrapped % 64)))
+			return true;
+	}
+
+	return false;
+}
+
 // GSTextureCache::SourceMap
 
 void GSTextureCache::SourceMap::Add(Source* s, const GIFRegTEX0& TEX0)
@@ -6101,6 +6271,247 @@ void GSTextureCache::PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TE
 	}
 }
 
+// Only the fields which select the blocks that get hashed.
+static constexpr u64 PREFETCH_TEX0_MASK = 0x00000003FFFFFFFFULL; // TBP0 TBW PSM TW TH
+
+static u64 GetPrefetchTEXA(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
+{
+	// TEXA only changes the hash when 16/24-bit direct formats get expanded.
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
+	return (psm.pal == 0 && psm.fmt > 0) ? (TEXA.U64 & 0x000000FF000080FFULL) : 0;
+}
+
+void GSTextureCache::PrefetchTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
+{
+	if (!CanCacheTextureSize(TEX0.TW, TEX0.TH) && !CanPreloadTextureSize(TEX0.TW, TEX0.TH))
+		return;
+
+	// Cheaper to combine the page hashes on demand, unless the hash is going to be persisted.
+	if (CanHashTexturePages(TEX0, SourceRegion()) && !GSConfig.DumpReplaceableTextures && !GSConfig.LoadTextureReplacements)
+		return;
+
+	// Only worth it when the lookup falls through to the hash cache, not when the source cache already has
+	// the texture, or it may come from a target. Every local memory write would wait for it otherwise.
+	for (const Source* s : m_src.m_map[TEX0.TBP0 >> 5])
+	{
+		if (((TEX0.U32[0] ^ s->m_TEX0.U32[0]) | ((TEX0.U32[1] ^ s->m_TEX0.U32[1]) & 3)) == 0) // TBP0 TBW PSM TW TH
+			return;
+	}
+	const u32 end_bp = GSLocalMemory::GetUnwrappedEndBlockAddress(TEX0.TBP0, TEX0.TBW, TEX0.PSM,
+		GSVector4i(0, 0, 1 << TEX0.TW, 1 << TEX0.TH));
+	if (MayOverlapTarget(TEX0.TBP0, end_bp))
+		return;
+
+	const u64 tex0 = TEX0.U64 & PREFETCH_TEX0_MASK;
+	const u64 texa = GetPrefetchTEXA(TEX0, TEXA);
+
+	std::unique_lock<std::mutex> lock(m_prefetch_mutex);
+
+	// Reuse an empty slot, or the oldest finished one. If everything is still queued, the
+	// thread is behind, and the draw will just hash it itself.
+	TexturePrefetch* slot = nullptr;
+	for (TexturePrefetch& p : m_prefetches)
+	{
+		if (p.state != TexturePrefetch::State::Empty && p.TEX0.U64 == tex0 && p.TEXA.U64 == texa)
+			return;
+
+		if (p.state == TexturePrefetch::State::Empty)
+		{
+			if (!slot || slot->state != TexturePrefetch::State::Empty)
+				slot = &p;
+		}
+		else if (p.state == TexturePrefetch::State::Done)
+		{
+			if (!slot || (slot->state == TexturePrefetch::State::Done && static_cast<s32>(p.seq - slot->seq) < 0))
+				slot = &p;
+		}
+	}
+	if (!slot)
+		return;
+
+	slot->TEX0.U64 = tex0;
+	slot->TEXA.U64 = texa;
+	slot->seq = m_prefetch_seq++;
+	slot->state = TexturePrefetch::State::Queued;
+	m_prefetch_active = true;
+	lock.unlock();
+
+	StartPrefetchThread();
+	m_prefetch_work_cv.notify_one();
+}
+
+bool GSTextureCache::GetPrefetchedHash(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, HashType* hash)
+{
+	if (!m_prefetch_active)
+		return false;
+
+	const u64 tex0 = TEX0.U64 & PREFETCH_TEX0_MASK;
+	const u64 texa = GetPrefetchTEXA(TEX0, TEXA);
+
+	std::unique_lock<std::mutex> lock(m_prefetch_mutex);
+	for (TexturePrefetch& p : m_prefetches)
+	{
+		if (p.state == TexturePrefetch::State::Empty || p.TEX0.U64 != tex0 || p.TEXA.U64 != texa)
+			continue;
+
+		// Still waiting behind other textures, quicker to hash it here than to wait.
+		if (p.state == TexturePrefetch::State::Queued)
+		{
+			p.state = TexturePrefetch::State::Empty;
+			return false;
+		}
+
+		m_prefetch_done_cv.wait(lock, [&p]() { return p.state != TexturePrefetch::State::Running; });
+		if (p.state != TexturePrefetch::State::Done)
+			return false;
+
+		*hash = p.hash;
+		return true;
+	}
+
+	return false;
+}
+
+void GSTextureCache::CancelTexturePrefetch()
+{
+	if (!m_prefetch_active)
+		return;
+
+	std::unique_lock<std::mutex> lock(m_prefetch_mutex);
+
+	// Drop anything which hasn't started, then wait for the thread to stop reading local memory.
+	for (TexturePrefetch& p : m_prefetches)
+	{
+		if (p.state == TexturePrefetch::State::Queued)
+			p.state = TexturePrefetch::State::Empty;
+	}
+
+	m_prefetch_done_cv.wait(lock, [this]() {
+		return std::none_of(m_prefetches.begin(), m_prefetches.end(),
+			[](const TexturePrefetch& p) { return p.state == TexturePrefetch::State::Running; });
+	});
+
+	for (TexturePrefetch& p : m_prefetches)
+		p.state = TexturePrefetch::State::Empty;
+
+	m_prefetch_active = false;
+}
+
+void GSTextureCache::InvalidateLocalMemHashes(const GSOffset& off, const GSVector4i& r)
+{
+	CancelTexturePrefetch();
+
+	off.loopPages(r, [this](u32 page) { m_page_hash_valid[page / 64] &= ~(1ULL << (page % 64)); });
+}
+
+void GSTextureCache::InvalidateAllLocalMemHashes()
+{
+	CancelTexturePrefetch();
+
+	m_page_hash_valid.fill(0);
+}
+
+bool GSTextureCache::CanHashTexturePages(const GIFRegTEX0& TEX0, SourceRegion region)
+{
+	// The texture has to cover its pages completely, using every bit, with the rows laid out the same
+	// regardless of TBW. Otherwise unrelated data in the pages would make the hash change spuriously,
+	// or identical textures at different widths would produce different hashes.
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
+	const u32 tw = 1u << TEX0.TW;
+	const u32 th = 1u << TEX0.TH;
+	const u32 bw = TEX0.TBW * 64;
+	return (!region.HasEither() && (TEX0.TBP0 & 31) == 0 && psm.fmsk == 0xFFFFFFFFu &&
+			(tw % psm.pgs.x) == 0 && (th % psm.pgs.y) == 0 && tw <= bw && (bw % psm.pgs.x) == 0);
+}
+
+GSTextureCache::HashType GSTextureCache::HashTexturePages(const GIFRegTEX0& TEX0)
+{
+	GSLocalMemory& mem = g_gs_renderer->m_mem;
+	const GSOffset off = mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM);
+
+	BlockHashState hash_st;
+	BlockHashReset(hash_st);
+
+	off.loopPages(GSVector4i(0, 0, 1 << TEX0.TW, 1 << TEX0.TH), [this, &mem, &hash_st](u32 page) {
+		const u64 mask = 1ULL << (page % 64);
+		if (!(m_page_hash_valid[page / 64] & mask))
+		{
+			m_page_hashes[page] = GSXXH3_64bits(mem.vm8() + page * PAGE_SIZE, PAGE_SIZE);
+			m_page_hash_valid[page / 64] |= mask;
+		}
+
+		BlockHashAccumulate(hash_st, reinterpret_cast<const u8*>(&m_page_hashes[page]), sizeof(HashType));
+	});
+
+	return FinishBlockHash(hash_st);
+}
+
+void GSTextureCache::StartPrefetchThread()
+{
+	if (m_prefetch_thread.joinable())
+		return;
+
+	// Same size as the unswizzle buffer, the thread can't share it with the GS thread.
+	m_prefetch_buffer = static_cast<u8*>(_aligned_malloc(9 * 1024 * 1024, VECTOR_ALIGNMENT));
+	pxAssertRel(m_prefetch_buffer, "Failed to allocate prefetch buffer");
+
+	m_prefetch_thread_running = true;
+	m_prefetch_thread = std::thread(&GSTextureCache::PrefetchThreadEntryPoint, this);
+}
+
+void GSTextureCache::StopPrefetchThread()
+{
+	if (!m_prefetch_thread.joinable())
+		return;
+
+	{
+		std::unique_lock<std::mutex> lock(m_prefetch_mutex);
+		m_prefetch_thread_running = false;
+		m_prefetch_work_cv.notify_one();
+	}
+
+	m_prefetch_thread.join();
+
+	_aligned_free(m_prefetch_buffer);
+	m_prefetch_buffer = nullptr;
+}
+
+void GSTextureCache::PrefetchThreadEntryPoint()
+{
+	std::unique_lock<std::mutex> lock(m_prefetch_mutex);
+	while (m_prefetch_thread_running)
+	{
+		// Oldest first, the draw for it is the most likely to come next.
+		TexturePrefetch* next = nullptr;
+		for (TexturePrefetch& p : m_prefetches)
+		{
+			if (p.state == TexturePrefetch::State::Queued && (!next || static_cast<s32>(p.seq - next->seq) < 0))
+				next = &p;
+		}
+		if (!next)
+		{
+			m_prefetch_work_cv.wait(lock);
+			continue;
+		}
+
+		next->state = TexturePrefetch::State::Running;
+		const GIFRegTEX0 TEX0 = next->TEX0;
+		const GIFRegTEXA TEXA = next->TEXA;
+		lock.unlock();
+
+		// Local memory can't be written while we're running, CancelTexturePrefetch() waits for us.
+		BlockHashState hash_st;
+		BlockHashReset(hash_st);
+		HashTextureLevel(TEX0, TEXA, SourceRegion(), hash_st, m_prefetch_buffer);
+		const HashType hash = FinishBlockHash(hash_st);
+
+		lock.lock();
+		next->hash = hash;
+		next->state = TexturePrefetch::State::Done;
+		m_prefetch_done_cv.notify_all();
+	}
+}
+
 GSTextureCache::HashCacheKey::HashCacheKey()
 	: TEX0Hash(0)
 	, CLUTHash(0)
@@ -6109,7 +6520,8 @@ GSTextureCache::HashCacheKey::HashCacheKey()
 	TEXA.U64 = 0;
 }
 
-GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const u32* clut, const GSVector2i* lod, SourceRegion region)
+GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const u32* clut, const GSVector2i* lod, SourceRegion region,
+	const HashType* base_hash)
 {
 	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
 
@@ -6119,6 +6531,14 @@ GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTE
 	ret.CLUTHash = clut ? GSTextureCache::PaletteKeyHash{}({clut, psm.pal}) : 0;
 	ret.region = region;
 
+	// precomputed hashes only cover the base level, so they can't be combined with mips
+	if (base_hash)
+	{
+		pxAssert(!lod);
+		ret.TEX0Hash = *base_hash;
+		return ret;
+	}
+
 	BlockHashState hash_st;
 	BlockHashReset(hash_st);
 
@@ -22,6 +22,10 @@
 #include <unordered_set>
 #include <utility>
 #include <limits>
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 class GSHwHack;
 
@@ -105,7 +109,8 @@ public:
 
 		HashCacheKey();
 
-		static HashCacheKey Create(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const u32* clut, const GSVector2i* lod, SourceRegion region);
+		static HashCacheKey Create(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const u32* clut, const GSVector2i* lod, SourceRegion region,
+			const HashType* base_hash = nullptr);
 
 		HashCacheKey WithRemovedCLUTHash() const;
 		void RemoveCLUTHash();
@@ -351,6 +356,23 @@ public:
 		void RemoveAt(Source* s);
 	};
 
+	/// Page coverage of the targets of one type, used to reject overlap queries without walking m_dst.
+	/// Pages are marked as soon as a target is created or moves/grows, but only cleared when the map is
+	/// rebuilt, so it is always a superset: an unmarked page is guaranteed not to hold any target.
+	/// The lists stay authoritative since lookups depend on their MRU order.
+	class TargetPageMap
+	{
+	public:
+		void Clear() { m_pages.fill(0); }
+		void Add(const Target* t);
+
+		/// Returns true if any target may touch the blocks in [start_bp, end_bp] (end unwrapped).
+		bool Overlaps(u32 start_bp, u32 end_bp) const;
+
+	private:
+		std::array<u64, MAX_PAGES / 64> m_pages = {};
+	};
+
 	struct TargetHeightElem
 	{
 		union
@@ -409,6 +431,7 @@ protected:
 	u64 m_hash_cache_replacement_memory_usage = 0;
 
 	FastList<Target*> m_dst[2];
+	TargetPageMap m_dst_pages[2];
 	FastList<TargetHeightElem> m_target_heights;
 	u64 m_target_memory_usage = 0;
 
@@ -418,8 +441,52 @@ protected:
 	Source* m_temporary_source = nullptr; // invalidated after the draw
 
 	std::unique_ptr<GSDownloadTexture> m_color_download_texture;
-	std::unique_ptr<GSDownloadTexture> m_uint16_download_texture;
-	std::unique_ptr<GSDownloadTexture> m_uint32_download_texture;
+
+	/// Target downloads which have been copied on the GPU but not written back to local memory yet.
+	struct PendingReadback
+	{
+		std::unique_ptr<GSDownloadTexture> texture;
+		GIFRegTEX0 TEX0;
+		GSVector4i rect;
+		u32 write_mask;
+	};
+	constexpr static size_t MAX_READBACK_TEXTURES = 4;
+	std::vector<PendingReadback> m_pending_readbacks;
+	std::vector<std::unique_ptr<GSDownloadTexture>> m_readback_textures;
+
+	/// Texture hashes computed on the prefetch thread when TEX0 is written. Entries stay valid until
+	/// local memory is written, which must go through InvalidateLocalMemHashes() first.
+	struct TexturePrefetch
+	{
+		enum class State : u8
+		{
+			Empty,
+			Queued,
+			Running,
+			Done
+		};
+
+		GIFRegTEX0 TEX0;
+		GIFRegTEXA TEXA;
+		HashType hash;
+		u32 seq;
+		State state;
+	};
+	constexpr static size_t MAX_TEXTURE_PREFETCHES = 8;
+	std::array<TexturePrefetch, MAX_TEXTURE_PREFETCHES> m_prefetches = {};
+	std::thread m_prefetch_thread;
+	std::mutex m_prefetch_mutex;
+	std::condition_variable m_prefetch_work_cv;
+	std::condition_variable m_prefetch_done_cv;
+	u8* m_prefetch_buffer = nullptr;
+	u32 m_prefetch_seq = 0;
+	bool m_prefetch_active = false;
+	bool m_prefetch_thread_running = false;
+
+	/// Hashes of each page of local memory, computed on demand. Textures covering whole pages combine
+	/// these instead of hashing every block, so only pages written since the last lookup get rehashed.
+	std::array<HashType, MAX_PAGES> m_page_hashes;
+	std::array<u64, MAX_PAGES / 64> m_page_hash_valid = {};
 
 	Source* CreateSource(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, Target* t, bool half_right, int x_offset, int y_offset, const GSVector2i* lod, const GSVector4i* src_range, GSTexture* gpu_clut, SourceRegion region);
 
@@ -436,6 +503,13 @@ protected:
 	/// Resizes the download texture if needed.
 	bool PrepareDownloadTexture(u32 width, u32 height, GSTexture::Format format, std::unique_ptr<GSDownloadTexture>* tex);
 
+	/// Takes a download texture of at least the given size from the pool, or creates one.
+	std::unique_ptr<GSDownloadTexture> GetReadbackTexture(u32 width, u32 height, GSTexture::Format format);
+	void RecycleReadbackTexture(std::unique_ptr<GSDownloadTexture> tex);
+
+	/// Queues the GPU copy for a target readback, the data reaches local memory in FlushReadbacks().
+	bool QueueRead(Target* t, const GSVector4i& r);
+
 	HashCacheEntry* LookupHashCache(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, bool& paltex, const u32* clut, const GSVector2i* lod, SourceRegion region);
 	void RemoveFromHashCache(HashCacheMap::iterator it);
 	void AgeHashCache();
@@ -443,6 +517,21 @@ protected:
 	static void PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, GSLocalMemory& mem, bool paltex, GSTexture* tex, u32 level, std::pair<u8, u8>* alpha_minmax);
 	static HashType HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region);
 
+	void StartPrefetchThread();
+	void StopPrefetchThread();
+	void PrefetchThreadEntryPoint();
+
+	/// Returns the prefetched hash of the base level, waiting if it is currently being computed.
+	bool GetPrefetchedHash(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, HashType* hash);
+
+	/// Discards all prefetched hashes, waiting for the one in progress.
+	void CancelTexturePrefetch();
+
+	/// Returns true if the texture can be hashed from the per-page hashes. These values differ from
+	/// HashTexture(), so they can't be used where hashes are persisted (dumping/replacements).
+	static bool CanHashTexturePages(const GIFRegTEX0& TEX0, SourceRegion region);
+	HashType HashTexturePages(const GIFRegTEX0& TEX0);
+
 	// TODO: virtual void Write(Source* s, const GSVector4i& r) = 0;
 	// TODO: virtual void Write(Target* t, const GSVector4i& r) = 0;
 
@@ -459,11 +548,31 @@ public:
 	__fi u64 GetTargetMemoryUsage() const { return m_target_memory_usage; }
 
 	void Read(Target* t, const GSVector4i& r);
+
+	/// Waits for all queued target readbacks and writes them to local memory.
+	void FlushReadbacks();
 	void Read(Source* t, const GSVector4i& r);
+
+	/// Starts hashing a texture in the background, called as soon as TEX0 is written.
+	void PrefetchTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
+
+	/// Must be called before anything writes to local memory. Drops prefetched texture hashes,
+	/// and the page hashes covering the write.
+	void InvalidateLocalMemHashes(const GSOffset& off, const GSVector4i& r);
+	void InvalidateAllLocalMemHashes();
 	void RemoveAll();
 	void ReadbackAll();
 	void AddDirtyRectTarget(Target* target, GSVector4i rect, u32 psm, u32 bw, RGBAMask rgba, bool req_linear = false);
 	void ResizeTarget(Target* t, GSVector4i rect, u32 tbp, u32 psm, u32 tbw);
+
+	/// Must be called when a target's TBP0 or end block changes outside of the texture cache.
+	void UpdateTargetPages(const Target* t) { m_dst_pages[t->m_type].Add(t); }
+
+	/// Returns true if any target may touch the blocks in [start_bp, end_bp] (end unwrapped).
+	bool MayOverlapTarget(u32 start_bp, u32 end_bp) const
+	{
+		return m_dst_pages[RenderTarget].Overlaps(start_bp, end_bp) || m_dst_pages[DepthStencil].Overlaps(start_bp, end_bp);
+	}
 	static bool FullRectDirty(Target* target, u32 rgba_mask);
 	static bool FullRectDirty(Target* target);
 	bool CanTranslate(u32 bp, u32 bw, u32 spsm, GSVector4i r, u32 dbp, u32 dpsm, u32 dbw);
@@ -2338,6 +2338,28 @@ void GSDeviceOGL::SetupPipeline(const ProgramSelector& psel)
 	m_shader_cache.GetProgram(&prog, vs, ps);
 	it = m_programs.emplace(psel, std::move(prog)).first;
 	it->second.Bind();
+	m_pipeline_journal.Record(&psel);
+}
+
+u32 GSDeviceOGL::GetPipelineJournalKeySize() const
+{
+	return sizeof(ProgramSelector);
+}
+
+void GSDeviceOGL::PrecompilePipeline(const void* key)
+{
+	ProgramSelector psel;
+	std::memcpy(&psel, key, sizeof(psel));
+	if (m_programs.find(psel) != m_programs.end())
+		return;
+
+	// Linking doesn't touch the bound program, so this is safe mid-frame.
+	const std::string vs(GetVSSource(psel.vs));
+	const std::string ps(GetPSSource(psel.ps));
+
+	GLProgram prog;
+	m_shader_cache.GetProgram(&prog, vs, ps);
+	m_programs.emplace(psel, std::move(prog));
 }
 
 void GSDeviceOGL::SetupSampler(PSSamplerSelector ssel)
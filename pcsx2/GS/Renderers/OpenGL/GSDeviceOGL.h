@@ -373,6 +373,8 @@ public:
 	GSDepthStencilOGL* CreateDepthStencil(OMDepthStencilSelector dssel);
 
 	void SetupPipeline(const ProgramSelector& psel);
+	u32 GetPipelineJournalKeySize() const override;
+	void PrecompilePipeline(const void* key) override;
 	void SetupSampler(PSSamplerSelector ssel);
 	void SetupOM(OMDepthStencilSelector dssel);
 	GLuint GetSamplerID(PSSamplerSelector ssel);
@@ -4856,9 +4856,24 @@ VkPipeline GSDeviceVK::GetTFXPipeline(const PipelineSelector& p)
 
 	VkPipeline pipeline = CreateTFXPipeline(p);
 	m_tfx_pipelines.emplace(p, pipeline);
+	if (pipeline != VK_NULL_HANDLE)
+		m_pipeline_journal.Record(&p);
+
 	return pipeline;
 }
 
+u32 GSDeviceVK::GetPipelineJournalKeySize() const
+{
+	return sizeof(PipelineSelector);
+}
+
+void GSDeviceVK::PrecompilePipeline(const void* key)
+{
+	PipelineSelector p;
+	std::memcpy(&p, key, sizeof(p));
+	GetTFXPipeline(p);
+}
+
 bool GSDeviceVK::BindDrawPipeline(const PipelineSelector& p)
 {
 	VkPipeline pipeline = GetTFXPipeline(p);
@@ -26,6 +26,7 @@
 
 struct GS_Packet;
 extern void Gif_MTGS_Wait(bool isMTVU);
+extern void Gif_MTGS_PostMTVU();
 extern void Gif_FinishIRQ();
 extern bool Gif_HandlerAD(u8* pMem);
 extern bool Gif_HandlerAD_MTVU(u8* pMem);
@@ -195,11 +196,17 @@ struct Gif_Path_MTVU
 	// memory overhead. Note the struct is instantied 3 times (for each gif
 	// path)
 	ringbuffer_base<GS_Packet, MTGS::RingBufferSize / 2> gsPackQueue;
+	// Number of gsPackQueue packets committed by each finished vu1 program,
+	// which tells MTGS where one program's MTVUGSPacket ends.
+	ringbuffer_base<u32, 1024> programEnds;
+	u32 programPackets; // Packets committed so far by the running vu1 program (MTVU thread)
 	Gif_Path_MTVU() { Reset(); }
 	void Reset()
 	{
 		fakePackets = 0;
 		gsPackQueue.reset();
+		programEnds.reset();
+		programPackets = 0;
 		fakePacket.Reset();
 		fakePacket.size = ~0u; // Used to indicate that its a fake packet
 	}
@@ -478,19 +485,36 @@ struct Gif_Path
 		gifTag.isValid = false;
 	}
 
-	// MTVU: Gets called after VU1 execution on MTVU thread
-	void FinishGSPacketMTVU()
+	// MTVU: Publishes the xgkick data gathered so far on MTVU thread, so MTGS can
+	// start transferring it while the vu1 program is still running.
+	// If last is set, this closes the vu1 program's MTVUGSPacket on MTGS.
+	void CommitGSPacketMTVU(bool last)
 	{
 		// Performance note: fetch_add atomic operation might create some stall for atomic
 		// operation in gsPack.push
 		readAmount.fetch_add(gsPack.size + gsPack.readAmount, std::memory_order_acq_rel);
 		while (!mtvu.gsPackQueue.push(gsPack))
 			;
+		mtvu.programPackets++;
+		if (last)
+		{
+			// Must be visible before MTGS is woken for the final packet
+			while (!mtvu.programEnds.push(mtvu.programPackets))
+				;
+			mtvu.programPackets = 0;
+		}
+		Gif_MTGS_PostMTVU();
 
 		gsPack.Reset();
 		gsPack.offset = curOffset;
 	}
 
+	// MTVU: Gets called after VU1 execution on MTVU thread
+	void FinishGSPacketMTVU()
+	{
+		CommitGSPacketMTVU(true);
+	}
+
 	// MTVU: Gets called by MTGS thread
 	GS_Packet GetGSPacketMTVU()
 	{
@@ -511,6 +535,17 @@ struct Gif_Path
 		mtvu.gsPackQueue.pop();
 	}
 
+	// MTVU: Gets called by MTGS thread, after transferring the given number of
+	// packets for the current vu1 program. Returns true if that was all of them.
+	bool PopProgramEndMTVU(u32 packets)
+	{
+		if (mtvu.programEnds.empty() || mtvu.programEnds.front() != packets)
+			return false;
+
+		mtvu.programEnds.pop();
+		return true;
+	}
+
 	// MTVU: Returns the amount of pending
 	// GS Packets that MTGS hasn't yet processed
 	u32 GetPendingGSPackets()
@@ -621,6 +656,7 @@ struct Gif_Unit
 			{ // This is on the MTVU thread
 				path1.CopyGSPacketData(pMem, size, aligned);
 				path1.ExecuteGSPacketMTVU();
+				path1.CommitGSPacketMTVU(false);
 				return size;
 			}
 			if (tranType == GIF_TRANS_MTVU)
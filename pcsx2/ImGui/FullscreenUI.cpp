@@ -4246,6 +4246,9 @@ void FullscreenUI::DrawAdvancedSettingsPage()
 			"EmuCore/CPU/Recompiler", "EnableVU1", true);
 		DrawToggleSetting(bsi, "Enable VU Flag Optimization", "Good speedup and high compatibility, may cause graphical errors.",
 			"EmuCore/Speedhacks", "vuFlagHack", true);
+		DrawToggleSetting(bsi, "Cache Compiled VU Programs",
+			"Compiles the VU programs a game used previously when it boots, instead of when they first run.", "EmuCore/CPU/Recompiler",
+			"EnableVUProgramCache", true);
 
 		MenuHeading("I/O Processor");
 		DrawToggleSetting(bsi, "Enable IOP Recompiler",
@@ -54,6 +54,7 @@
 namespace ImGuiManager
 {
 	static void FormatProcessorStat(std::string& text, double usage, double time);
+	static void FormatRingStat(std::string& text, float usage, u32 stalls, float stall_time);
 	static void DrawPerformanceOverlay(float& position_y);
 	static void DrawSettingsOverlay();
 	static void DrawInputsOverlay();
@@ -97,6 +98,12 @@ void ImGuiManager::FormatProcessorStat(std::string& text, double usage, double t
 		fmt::format_to(std::back_inserter(text), "{:.1f}% ({:.2f}ms)", usage, time);
 }
 
+void ImGuiManager::FormatRingStat(std::string& text, float usage, u32 stalls, float stall_time)
+{
+	// Peak fill of the ring, and how long the EE was held back waiting for the consumer.
+	fmt::format_to(std::back_inserter(text), "{:.0f}% | {} stalls ({:.2f}ms)", usage, stalls, stall_time);
+}
+
 void ImGuiManager::DrawPerformanceOverlay(float& position_y)
 {
 	const float scale = ImGuiManager::GetGlobalScale();
@@ -216,6 +223,10 @@ void ImGuiManager::DrawPerformanceOverlay(float& position_y)
 			FormatProcessorStat(text, PerformanceMetrics::GetGSThreadUsage(), PerformanceMetrics::GetGSThreadAverageTime());
 			DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
 
+			text = "GS Ring: ";
+			FormatRingStat(text, PerformanceMetrics::GetGSRingUsage(), PerformanceMetrics::GetGSRingStalls(), PerformanceMetrics::GetGSRingStallTime());
+			DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+
 			const u32 gs_sw_threads = PerformanceMetrics::GetGSSWThreadCount();
 			for (u32 i = 0; i < gs_sw_threads; i++)
 			{
@@ -230,6 +241,10 @@ void ImGuiManager::DrawPerformanceOverlay(float& position_y)
 				text = "VU: ";
 				FormatProcessorStat(text, PerformanceMetrics::GetVUThreadUsage(), PerformanceMetrics::GetVUThreadAverageTime());
 				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+
+				text = "VU Ring: ";
+				FormatRingStat(text, PerformanceMetrics::GetVURingUsage(), PerformanceMetrics::GetVURingStalls(), PerformanceMetrics::GetVURingStallTime());
+				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
 			}
 
 			if (GSCapture::IsCapturing())
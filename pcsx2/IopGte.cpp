@@ -543,10 +543,50 @@ else gteIR3=(long)gteMAC3; \
 
 //********END OF LIMITATIONS**********************************/
 
+//********SIMD HELPERS****************************************/
+// The 3x3 matrix products below are computed with 32-bit wrapping lanes, exactly like the
+// int arithmetic of the scalar expressions they replace. Lane 3 of every vector is kept at
+// zero so the fourth s16 loaded past the end of each matrix row never contributes.
+
+// Sign-extends the three s16 components at v into lanes 0..2.
+static __fi __m128i gteLoadVector(const s16* v)
+{
+	const __m128i r = _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(v)));
+	return _mm_blend_epi16(r, _mm_setzero_si128(), 0xC0);
+}
+
+// Loads three consecutive s32 registers (IR1..IR3, BK, TR, FC) into lanes 0..2.
+static __fi __m128i gteLoadVector32(const s32* v)
+{
+	return _mm_blend_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(v)), _mm_setzero_si128(), 0xC0);
+}
+
+// Row-major 3x3 s16 matrix at m times v, one row per result lane.
+static __fi __m128i gteMatrixVector(const s16* m, __m128i v)
+{
+	const __m128i r1 = _mm_mullo_epi32(_mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(m))), v);
+	const __m128i r2 = _mm_mullo_epi32(_mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(m + 3))), v);
+	const __m128i r3 = _mm_mullo_epi32(_mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(m + 6))), v);
+	return _mm_hadd_epi32(_mm_hadd_epi32(r1, r2), _mm_hadd_epi32(r3, _mm_setzero_si128()));
+}
+
+// BK + ((LR * limA(L * v >> 12)) >> 12), shared by NCS/NCCS/NCDS. Flags are raised in the
+// same order as the scalar code.
+static __fi __m128i gteLightColor(const s16* v)
+{
+	const __m128i ll = _mm_srai_epi32(gteMatrixVector(&gteL11, gteLoadVector(v)), 12);
+	const s32 ll1 = F12limA1U(_mm_cvtsi128_si32(ll));
+	const s32 ll2 = F12limA2U(_mm_extract_epi32(ll, 1));
+	const s32 ll3 = F12limA3U(_mm_extract_epi32(ll, 2));
+	const __m128i lc = _mm_srai_epi32(gteMatrixVector(&gteLR1, _mm_setr_epi32(ll1, ll2, ll3, 0)), 12);
+	return _mm_add_epi32(gteLoadVector32(&gteRBK), lc);
+}
+
 #define GTE_RTPS1(vn) { \
-	gteMAC1 = FNC_OVERFLOW1(((signed long)(gteR11*gteVX##vn + gteR12*gteVY##vn + gteR13*gteVZ##vn)>>12) + gteTRX); \
-	gteMAC2 = FNC_OVERFLOW2(((signed long)(gteR21*gteVX##vn + gteR22*gteVY##vn + gteR23*gteVZ##vn)>>12) + gteTRY); \
-	gteMAC3 = FNC_OVERFLOW3(((signed long)(gteR31*gteVX##vn + gteR32*gteVY##vn + gteR33*gteVZ##vn)>>12) + gteTRZ); \
+	const __m128i gte_RV = _mm_srai_epi32(gteMatrixVector(&gteR11, gteLoadVector(&gteVX##vn)), 12); \
+	gteMAC1 = FNC_OVERFLOW1((s64)_mm_cvtsi128_si32(gte_RV) + gteTRX); \
+	gteMAC2 = FNC_OVERFLOW2((s64)_mm_extract_epi32(gte_RV, 1) + gteTRY); \
+	gteMAC3 = FNC_OVERFLOW3((s64)_mm_extract_epi32(gte_RV, 2) + gteTRZ); \
 }
 
 /*	gteMAC1 = NC_OVERFLOW1(((signed long)(gteR11*gteVX0 + gteR12*gteVY0 + gteR13*gteVZ0)>>12) + gteTRX);
@@ -943,12 +983,6 @@ void gteRTPT() {
 #define gte_C32 gteLB2
 #define gte_C33 gteLB3
 
-#define _MVMVA_FUNC(_v0, _v1, _v2, mx) { \
-	SSX = (_v0) * mx##11 + (_v1) * mx##12 + (_v2) * mx##13; \
-	SSY = (_v0) * mx##21 + (_v1) * mx##22 + (_v2) * mx##23; \
-	SSZ = (_v0) * mx##31 + (_v1) * mx##32 + (_v2) * mx##33; \
-}
-
 void gteMVMVA() {
 	//	double SSX, SSY, SSZ;
 	s64 SSX, SSY, SSZ;
@@ -957,33 +991,22 @@ void gteMVMVA() {
 	GTE_LOG("GTE_MVMVA %lx\n", psxRegs.code & 0x1ffffff);
 #endif
 
-	switch (psxRegs.code & 0x78000) {
-	case 0x00000: // V0 * R
-		_MVMVA_FUNC(gteVX0, gteVY0, gteVZ0, gteR); break;
-	case 0x08000: // V1 * R
-		_MVMVA_FUNC(gteVX1, gteVY1, gteVZ1, gteR); break;
-	case 0x10000: // V2 * R
-		_MVMVA_FUNC(gteVX2, gteVY2, gteVZ2, gteR); break;
-	case 0x18000: // IR * R
-		_MVMVA_FUNC((short)gteIR1, (short)gteIR2, (short)gteIR3, gteR);
-		break;
-	case 0x20000: // V0 * L
-		_MVMVA_FUNC(gteVX0, gteVY0, gteVZ0, gteL); break;
-	case 0x28000: // V1 * L
-		_MVMVA_FUNC(gteVX1, gteVY1, gteVZ1, gteL); break;
-	case 0x30000: // V2 * L
-		_MVMVA_FUNC(gteVX2, gteVY2, gteVZ2, gteL); break;
-	case 0x38000: // IR * L
-		_MVMVA_FUNC((short)gteIR1, (short)gteIR2, (short)gteIR3, gteL); break;
-	case 0x40000: // V0 * C
-		_MVMVA_FUNC(gteVX0, gteVY0, gteVZ0, gte_C); break;
-	case 0x48000: // V1 * C
-		_MVMVA_FUNC(gteVX1, gteVY1, gteVZ1, gte_C); break;
-	case 0x50000: // V2 * C
-		_MVMVA_FUNC(gteVX2, gteVY2, gteVZ2, gte_C); break;
-	case 0x58000: // IR * C
-		_MVMVA_FUNC((short)gteIR1, (short)gteIR2, (short)gteIR3, gte_C); break;
-	default:
+	// Matrix 3 is reserved and produces zero, as does the default case of the scalar version.
+	const u32 mx = psxRegs.code & 0x60000;
+	if (mx != 0x60000) {
+		const s16* matrix = (mx == 0x00000) ? &gteR11 : (mx == 0x20000) ? &gteL11 : &gte_C11;
+		__m128i v;
+		switch (psxRegs.code & 0x18000) {
+		case 0x00000: v = gteLoadVector(&gteVX0); break; // V0
+		case 0x08000: v = gteLoadVector(&gteVX1); break; // V1
+		case 0x10000: v = gteLoadVector(&gteVX2); break; // V2
+		default: v = _mm_setr_epi32((short)gteIR1, (short)gteIR2, (short)gteIR3, 0); break; // IR
+		}
+		const __m128i ss = gteMatrixVector(matrix, v);
+		SSX = _mm_cvtsi128_si32(ss);
+		SSY = _mm_extract_epi32(ss, 1);
+		SSZ = _mm_extract_epi32(ss, 2);
+	} else {
 		SSX = SSY = SSZ = 0;
 	}
 
@@ -1383,17 +1406,16 @@ gteMAC1 = (long)(gteR*gte_RRLT*16); \
 gteMAC2 = (long)(gteG*gte_GGLT*16); \
 gteMAC3 = (long)(gteB*gte_BBLT*16); \
 */
-#define GTE_NCCS(vn) \
-	gte_LL1 = F12limA1U((gteL11*gteVX##vn + gteL12*gteVY##vn + gteL13*gteVZ##vn) >> 12); \
-	gte_LL2 = F12limA2U((gteL21*gteVX##vn + gteL22*gteVY##vn + gteL23*gteVZ##vn) >> 12); \
-	gte_LL3 = F12limA3U((gteL31*gteVX##vn + gteL32*gteVY##vn + gteL33*gteVZ##vn) >> 12); \
-	gte_RRLT= F12limA1U(gteRBK + ((gteLR1*gte_LL1 + gteLR2*gte_LL2 + gteLR3*gte_LL3) >> 12)); \
-	gte_GGLT= F12limA2U(gteGBK + ((gteLG1*gte_LL1 + gteLG2*gte_LL2 + gteLG3*gte_LL3) >> 12)); \
-	gte_BBLT= F12limA3U(gteBBK + ((gteLB1*gte_LL1 + gteLB2*gte_LL2 + gteLB3*gte_LL3) >> 12)); \
+#define GTE_NCCS(vn) { \
+	const __m128i gte_LC = gteLightColor(&gteVX##vn); \
+	gte_RRLT= F12limA1U(_mm_cvtsi128_si32(gte_LC)); \
+	gte_GGLT= F12limA2U(_mm_extract_epi32(gte_LC, 1)); \
+	gte_BBLT= F12limA3U(_mm_extract_epi32(gte_LC, 2)); \
 	\
 	gteMAC1 = (long)(((s64)((u32)gteR<<12)*gte_RRLT) >> 20);\
 	gteMAC2 = (long)(((s64)((u32)gteG<<12)*gte_GGLT) >> 20);\
-	gteMAC3 = (long)(((s64)((u32)gteB<<12)*gte_BBLT) >> 20);
+	gteMAC3 = (long)(((s64)((u32)gteB<<12)*gte_BBLT) >> 20); \
+}
 
 
 void gteNCCS() {
@@ -1401,7 +1423,6 @@ void gteNCCS() {
 	//	double t1, t2, t3;
 	//	double gte_LL1, gte_LL2, gte_LL3;
 	//	double gte_RRLT, gte_GGLT, gte_BBLT;
-	s32 gte_LL1, gte_LL2, gte_LL3;
 	s32 gte_RRLT, gte_GGLT, gte_BBLT;
 
 #ifdef GTE_DUMP
@@ -1482,7 +1503,6 @@ void gteNCCT() {
 	//	double t1, t2, t3;
 	//	double gte_LL1, gte_LL2, gte_LL3;
 	//	double gte_RRLT, gte_GGLT, gte_BBLT;
-	s32 gte_LL1, gte_LL2, gte_LL3;
 	s32 gte_RRLT, gte_GGLT, gte_BBLT;
 
 #ifdef GTE_DUMP
@@ -1610,20 +1630,19 @@ gteMAC1 = (long)(gte_RR0 << 4); \
 gteMAC2 = (long)(gte_GG0 << 4); \
 gteMAC3 = (long)(gte_BB0 << 4);
 */
-#define GTE_NCDS(vn) \
-	gte_LL1 = F12limA1U((gteL11*gteVX##vn + gteL12*gteVY##vn + gteL13*gteVZ##vn) >> 12); \
-	gte_LL2 = F12limA2U((gteL21*gteVX##vn + gteL22*gteVY##vn + gteL23*gteVZ##vn) >> 12); \
-	gte_LL3 = F12limA3U((gteL31*gteVX##vn + gteL32*gteVY##vn + gteL33*gteVZ##vn) >> 12); \
-	gte_RRLT= F12limA1U(gteRBK + ((gteLR1*gte_LL1 + gteLR2*gte_LL2 + gteLR3*gte_LL3) >> 12)); \
-	gte_GGLT= F12limA2U(gteGBK + ((gteLG1*gte_LL1 + gteLG2*gte_LL2 + gteLG3*gte_LL3) >> 12)); \
-	gte_BBLT= F12limA3U(gteBBK + ((gteLB1*gte_LL1 + gteLB2*gte_LL2 + gteLB3*gte_LL3) >> 12)); \
+#define GTE_NCDS(vn) { \
+	const __m128i gte_LC = gteLightColor(&gteVX##vn); \
+	gte_RRLT= F12limA1U(_mm_cvtsi128_si32(gte_LC)); \
+	gte_GGLT= F12limA2U(_mm_extract_epi32(gte_LC, 1)); \
+	gte_BBLT= F12limA3U(_mm_extract_epi32(gte_LC, 2)); \
 	\
 	gte_RR0 = (long)(((s64)((u32)gteR<<12)*gte_RRLT) >> 12);\
 	gte_GG0 = (long)(((s64)((u32)gteG<<12)*gte_GGLT) >> 12);\
 	gte_BB0 = (long)(((s64)((u32)gteB<<12)*gte_BBLT) >> 12);\
 	gteMAC1 = (long)((gte_RR0 + (((s64)gteIR0 * F12limA1S((s64)(gteRFC << 8) - gte_RR0)) >> 12)) >> 8);\
 	gteMAC2 = (long)((gte_GG0 + (((s64)gteIR0 * F12limA2S((s64)(gteGFC << 8) - gte_GG0)) >> 12)) >> 8);\
-	gteMAC3 = (long)((gte_BB0 + (((s64)gteIR0 * F12limA3S((s64)(gteBFC << 8) - gte_BB0)) >> 12)) >> 8);
+	gteMAC3 = (long)((gte_BB0 + (((s64)gteIR0 * F12limA3S((s64)(gteBFC << 8) - gte_BB0)) >> 12)) >> 8); \
+}
 
 void gteNCDS() {
 	/*	double tRLT,tRRLT;
@@ -1635,7 +1654,6 @@ void gteNCDS() {
 	unsigned long C,R,G,B;	*/
 	//	double gte_LL1, gte_LL2, gte_LL3;
 	//	double gte_RRLT, gte_GGLT, gte_BBLT;
-	s32 gte_LL1, gte_LL2, gte_LL3;
 	s32 gte_RRLT, gte_GGLT, gte_BBLT;
 	s32 gte_RR0, gte_GG0, gte_BB0;
 
@@ -1759,7 +1777,6 @@ void gteNCDT() {
 	unsigned long C,R,G,B;*/
 	//	double gte_LL1, gte_LL2, gte_LL3;
 	//	double gte_RRLT, gte_GGLT, gte_BBLT;
-	s32 gte_LL1, gte_LL2, gte_LL3;
 	s32 gte_RRLT, gte_GGLT, gte_BBLT;
 	s32 gte_RR0, gte_GG0, gte_BB0;
 
@@ -2645,17 +2662,15 @@ gteB2 = FlimB3(gteMAC3 >> 4); gteCODE2 = gteCODE;*/
 gteG2 = limB2(gteMAC2 / 16.0f); \
 gteB2 = limB3(gteMAC3 / 16.0f); gteCODE2 = gteCODE;*/
 
-#define	GTE_NCS(vn)  \
-	gte_LL1 = F12limA1U((gteL11*gteVX##vn + gteL12*gteVY##vn + gteL13*gteVZ##vn) >> 12); \
-	gte_LL2 = F12limA2U((gteL21*gteVX##vn + gteL22*gteVY##vn + gteL23*gteVZ##vn) >> 12); \
-	gte_LL3 = F12limA3U((gteL31*gteVX##vn + gteL32*gteVY##vn + gteL33*gteVZ##vn) >> 12); \
-	gteMAC1 = F12limA1U(gteRBK + ((gteLR1*gte_LL1 + gteLR2*gte_LL2 + gteLR3*gte_LL3) >> 12)); \
-	gteMAC2 = F12limA2U(gteGBK + ((gteLG1*gte_LL1 + gteLG2*gte_LL2 + gteLG3*gte_LL3) >> 12)); \
-	gteMAC3 = F12limA3U(gteBBK + ((gteLB1*gte_LL1 + gteLB2*gte_LL2 + gteLB3*gte_LL3) >> 12));
+#define	GTE_NCS(vn) { \
+	const __m128i gte_LC = gteLightColor(&gteVX##vn); \
+	gteMAC1 = F12limA1U(_mm_cvtsi128_si32(gte_LC)); \
+	gteMAC2 = F12limA2U(_mm_extract_epi32(gte_LC, 1)); \
+	gteMAC3 = F12limA3U(_mm_extract_epi32(gte_LC, 2)); \
+}
 
 void gteNCS() {
 	//	double RR0,GG0,BB0;
-	s32 gte_LL1, gte_LL2, gte_LL3;
 	//	s32 RR0,GG0,BB0;
 	//	double t1, t2, t3;
 #ifdef GTE_DUMP
@@ -2738,7 +2753,6 @@ void gteNCS() {
 
 void gteNCT() {
 	//	double RR0,GG0,BB0;
-	s32 gte_LL1, gte_LL2, gte_LL3;
 	//	s32 RR0,GG0,BB0;
 	//	double t1, t2, t3;
 #ifdef GTE_DUMP
@@ -2898,9 +2912,11 @@ void gteCC() {
 	gteMAC1 = gteR * RR0 / 256.0f;
 	gteMAC2 = gteG * GG0 / 256.0f;
 	gteMAC3 = gteB * BB0 / 256.0f;*/
-	RR0 = FNC_OVERFLOW1(gteRBK + ((gteLR1*gteIR1 + gteLR2*gteIR2 + gteLR3*gteIR3) >> 12));
-	GG0 = FNC_OVERFLOW2(gteGBK + ((gteLG1*gteIR1 + gteLG2*gteIR2 + gteLG3*gteIR3) >> 12));
-	BB0 = FNC_OVERFLOW3(gteBBK + ((gteLB1*gteIR1 + gteLB2*gteIR2 + gteLB3*gteIR3) >> 12));
+	const __m128i lc = _mm_add_epi32(gteLoadVector32(&gteRBK),
+		_mm_srai_epi32(gteMatrixVector(&gteLR1, gteLoadVector32(&gteIR1)), 12));
+	RR0 = FNC_OVERFLOW1(_mm_cvtsi128_si32(lc));
+	GG0 = FNC_OVERFLOW2(_mm_extract_epi32(lc, 1));
+	BB0 = FNC_OVERFLOW3(_mm_extract_epi32(lc, 2));
 
 	gteMAC1 = (gteR * RR0) >> 8;
 	gteMAC2 = (gteG * GG0) >> 8;
@@ -25,6 +25,7 @@
 
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 #include "common/WrappedMemCopy.h"
 
 #include <list>
@@ -93,6 +94,11 @@ namespace MTGS
 	static std::atomic<bool> s_SignalRingEnable;
 	static std::atomic<int> s_SignalRingPosition;
 
+	// Ring telemetry, written by the EE thread and consumed by PerformanceMetrics.
+	static std::atomic<u32> s_RingPeakUsed{0};
+	static std::atomic<u32> s_RingStalls{0};
+	static std::atomic<u64> s_RingStallTicks{0};
+
 	static std::atomic<int> s_QueuedFrameCount;
 	static std::atomic<bool> s_VsyncSignalListener;
 
@@ -472,20 +478,27 @@ void MTGS::MainLoop()
 
 				case Command::MTVUGSPacket:
 				{
-					MTVU_LOG("MTGS - Waiting on semaXGkick!");
-					if (!vu1Thread.semaXGkick.TryWait())
+					// MTVU commits each xgkick as it happens, so transfer them as they
+					// arrive until the vu1 program's final packet closes this slot.
+					Gif_Path& path = gifUnit.gifPath[GIF_PATH_1];
+					for (u32 packets = 1;; packets++)
 					{
-						mtvu_lock.unlock();
-						// Wait for MTVU to complete vu1 program
-						vu1Thread.semaXGkick.Wait();
-						mtvu_lock.lock();
+						MTVU_LOG("MTGS - Waiting on semaXGkick!");
+						if (!vu1Thread.semaXGkick.TryWait())
+						{
+							mtvu_lock.unlock();
+							// Wait for MTVU to xgkick or complete vu1 program
+							vu1Thread.semaXGkick.Wait();
+							mtvu_lock.lock();
+						}
+						GS_Packet gsPack = path.GetGSPacketMTVU(); // Get vu1 program's xgkick packet(s)
+						if (gsPack.size)
+							GSgifTransfer((u8*)&path.buffer[gsPack.offset], gsPack.size / 16);
+						path.readAmount.fetch_sub(gsPack.size + gsPack.readAmount, std::memory_order_acq_rel);
+						path.PopGSPacketMTVU(); // Should be done last, for proper Gif_MTGS_Wait()
+						if (path.PopProgramEndMTVU(packets))
+							break;
 					}
-					Gif_Path& path = gifUnit.gifPath[GIF_PATH_1];
-					GS_Packet gsPack = path.GetGSPacketMTVU(); // Get vu1 program's xgkick packet(s)
-					if (gsPack.size)
-						GSgifTransfer((u8*)&path.buffer[gsPack.offset], gsPack.size / 16);
-					path.readAmount.fetch_sub(gsPack.size + gsPack.readAmount, std::memory_order_acq_rel);
-					path.PopGSPacketMTVU(); // Should be done last, for proper Gif_MTGS_Wait()
 					break;
 				}
 
@@ -723,6 +736,13 @@ void MTGS::SendDataPacket()
 	//m_PacketLocker.Release();
 }
 
+// Returns true if writing size qwords would overrun the reader, or push the ring past the
+// user's limit. An empty ring always accepts the packet, so a small limit can't deadlock.
+static __fi bool IsRingFull(uint freeroom, uint size, uint limit)
+{
+	return (freeroom <= size) || (freeroom < MTGS::RingBufferSize && (MTGS::RingBufferSize - freeroom + size) > limit);
+}
+
 void MTGS::GenericStall(uint size)
 {
 	// Note on volatiles: m_WritePos is not modified by the GS thread, so there's no need
@@ -747,8 +767,15 @@ void MTGS::GenericStall(uint size)
 	else
 		freeroom = RingBufferSize - (writepos - readpos);
 
-	if (freeroom <= size)
+	const uint used = RingBufferSize - freeroom;
+	if (used > s_RingPeakUsed.load(std::memory_order_relaxed))
+		s_RingPeakUsed.store(used, std::memory_order_relaxed);
+
+	const uint limit = static_cast<uint>(static_cast<s64>(RingBufferSize) * EmuConfig.GS.MTGSRingLimit / 100);
+	if (IsRingFull(freeroom, size, limit))
 	{
+		const Common::Timer::Value stall_start = Common::Timer::GetCurrentValue();
+
 		// writepos will overlap readpos if we commit the data, so we need to wait until
 		// readpos is out past the end of the future write pos, or until it wraps around
 		// (in which case writepos will be >= readpos).
@@ -785,7 +812,7 @@ void MTGS::GenericStall(uint size)
 				else
 					freeroom = RingBufferSize - (writepos - readpos);
 
-				if (freeroom > size)
+				if (!IsRingFull(freeroom, size, limit))
 					break;
 			}
 
@@ -805,13 +832,26 @@ void MTGS::GenericStall(uint size)
 				else
 					freeroom = RingBufferSize - (writepos - readpos);
 
-				if (freeroom > size)
+				if (!IsRingFull(freeroom, size, limit))
 					break;
 			}
 		}
+
+		s_RingStalls.fetch_add(1, std::memory_order_relaxed);
+		s_RingStallTicks.fetch_add(Common::Timer::GetCurrentValue() - stall_start, std::memory_order_relaxed);
 	}
 }
 
+MTGS::RingStats MTGS::ConsumeRingStats()
+{
+	RingStats stats;
+	stats.size = static_cast<u32>(static_cast<s64>(RingBufferSize) * EmuConfig.GS.MTGSRingLimit / 100);
+	stats.peak_used = s_RingPeakUsed.exchange(0, std::memory_order_relaxed);
+	stats.stalls = s_RingStalls.exchange(0, std::memory_order_relaxed);
+	stats.stall_ticks = s_RingStallTicks.exchange(0, std::memory_order_relaxed);
+	return stats;
+}
+
 void MTGS::PrepDataPacket(Command cmd, u32 size)
 {
 	s_packet_size = size;
@@ -1112,4 +1152,9 @@ void Gif_AddBlankGSPacket(u32 size, GIF_PATH path)
 void Gif_MTGS_Wait(bool isMTVU)
 {
 	MTGS::WaitGS(false, true, isMTVU);
+}
+
+void Gif_MTGS_PostMTVU()
+{
+	vu1Thread.semaXGkick.Post();
 }
\ No newline at end of file
@@ -48,6 +48,15 @@ namespace MTGS
 		AsyncCall,
 	};
 
+	/// Ring buffer occupancy and backpressure, accumulated by the producer thread.
+	struct RingStats
+	{
+		u32 size; // Usable ring size, in ring units
+		u32 peak_used; // Highest occupancy seen by the producer
+		u32 stalls; // Number of times the producer waited for free space
+		u64 stall_ticks; // Time spent waiting, in Common::Timer ticks
+	};
+
 	struct FreezeData
 	{
 		freezeData* fdata;
@@ -92,6 +101,9 @@ namespace MTGS
 		u32* width, u32* height, std::vector<u32>* pixels);
 	void SetRunIdle(bool enabled);
 
+	/// Returns the GS ring stats gathered since the last call, and resets them.
+	RingStats ConsumeRingStats();
+
 	// Size of the ringbuffer as a power of 2 -- size is a multiple of simd128s.
 	// (actual size is 1<<m_RingBufferSizeFactor simd vectors [128-bit values])
 	// A value of 19 is a 8meg ring buffer.  18 would be 4 megs, and 20 would be 16 megs.
@@ -21,6 +21,8 @@
 #include "VMManager.h"
 #include "x86/newVif.h"
 
+#include "common/Timer.h"
+
 #include <thread>
 
 VU_Thread vu1Thread;
@@ -165,8 +167,7 @@ void VU_Thread::ExecuteRingBuffer()
 						VU1.VI[REG_TPC].UL = addr & 0x7FF;
 					CpuVU1->SetStartPC(VU1.VI[REG_TPC].UL << 3);
 					CpuVU1->Execute(vu1RunCycles);
-					gifUnit.gifPath[GIF_PATH_1].FinishGSPacketMTVU();
-					semaXGkick.Post(); // Tell MTGS a path1 packet is complete
+					gifUnit.gifPath[GIF_PATH_1].FinishGSPacketMTVU(); // Tells MTGS the path1 packet is complete
 					vuCycles[vuCycleIdx].store(VU1.cycle, std::memory_order_release);
 					vuCycleIdx = (vuCycleIdx + 1) & 3;
 					break;
@@ -225,18 +226,29 @@ void VU_Thread::ExecuteRingBuffer()
 // Should only be called by ReserveSpace()
 __ri void VU_Thread::WaitOnSize(s32 size)
 {
+	const s32 limit = static_cast<s32>(static_cast<s64>(buffer_size) * EmuConfig.GS.MTVURingLimit / 100);
+	Common::Timer::Value stall_start = 0;
 	for (;;)
 	{
 		s32 readPos = GetReadPos();
-		if (readPos <= m_write_pos)
-			break; // MTVU is reading in back of write_pos
-		// FIXME greg: there is a bug somewhere in the queue pointer
-		// management. It creates a deadlock/corruption in SotC intro (before
-		// the first menu). I added a 4KB safety net which seem to avoid to
-		// trigger the bug.
-		// Note: a wait lock instead of a yield also helps to avoid the bug.
-		if (readPos > m_write_pos + size + _4kb)
-			break; // Enough free front space
+		const s32 used = (m_write_pos - readPos) & (buffer_size - 1);
+		if (static_cast<u32>(used) > m_ring_peak_used.load(std::memory_order_relaxed))
+			m_ring_peak_used.store(used, std::memory_order_relaxed);
+		// An empty ring always takes the packet, so a small limit can't deadlock.
+		if (!used || used + size <= limit)
+		{
+			if (readPos <= m_write_pos)
+				break; // MTVU is reading in back of write_pos
+			// FIXME greg: there is a bug somewhere in the queue pointer
+			// management. It creates a deadlock/corruption in SotC intro (before
+			// the first menu). I added a 4KB safety net which seem to avoid to
+			// trigger the bug.
+			// Note: a wait lock instead of a yield also helps to avoid the bug.
+			if (readPos > m_write_pos + size + _4kb)
+				break; // Enough free front space
+		}
+		if (!stall_start)
+			stall_start = Common::Timer::GetCurrentValue();
 		{          // Let MTVU run to free up buffer space
 			KickStart();
 			// Locking might trigger a full flush of the ring buffer. Yield
@@ -246,6 +258,12 @@ __ri void VU_Thread::WaitOnSize(s32 size)
 			std::this_thread::yield();
 		}
 	}
+
+	if (stall_start)
+	{
+		m_ring_stalls.fetch_add(1, std::memory_order_relaxed);
+		m_ring_stall_ticks.fetch_add(Common::Timer::GetCurrentValue() - stall_start, std::memory_order_relaxed);
+	}
 }
 
 // Makes sure theres enough room in the ring buffer
@@ -446,6 +464,16 @@ bool VU_Thread::IsDone()
 	return GetReadPos() == GetWritePos();
 }
 
+MTGS::RingStats VU_Thread::ConsumeRingStats()
+{
+	MTGS::RingStats stats;
+	stats.size = static_cast<u32>(static_cast<s64>(buffer_size) * EmuConfig.GS.MTVURingLimit / 100);
+	stats.peak_used = m_ring_peak_used.exchange(0, std::memory_order_relaxed);
+	stats.stalls = m_ring_stalls.exchange(0, std::memory_order_relaxed);
+	stats.stall_ticks = m_ring_stall_ticks.exchange(0, std::memory_order_relaxed);
+	return stats;
+}
+
 void VU_Thread::WaitVU()
 {
 	MTVU_LOG("MTVU - WaitVU!");
@@ -15,6 +15,7 @@
 
 #pragma once
 #include "common/Threading.h"
+#include "MTGS.h"
 #include "Vif.h"
 #include "Vif_Dma.h"
 #include "VUmicro.h"
@@ -40,6 +41,11 @@ class VU_Thread final {
 	Threading::WorkSema semaEvent;
 	std::atomic_bool m_shutdown_flag{false};
 
+	// Ring telemetry, written by the EE thread and consumed by PerformanceMetrics.
+	std::atomic<u32> m_ring_peak_used{0};
+	std::atomic<u32> m_ring_stalls{0};
+	std::atomic<u64> m_ring_stall_ticks{0};
+
 	Threading::Thread m_thread;
 
 public:
@@ -107,6 +113,9 @@ public:
 
 	void WriteRow(vifStruct& _vif);
 
+	// Returns the ring stats gathered since the last call, and resets them.
+	MTGS::RingStats ConsumeRingStats();
+
 private:
 	void ExecuteRingBuffer();
 
@@ -297,6 +297,7 @@ Pcsx2Config::RecompilerOptions::RecompilerOptions()
 	EnableVU1 = true;
 	EnableFastmem = true;
 	PauseOnTLBMiss = false;
+	EnableVUProgramCache = true;
 
 	// vu and fpu clamping default to standard overflow.
 	vu0Overflow = true;
@@ -375,6 +376,7 @@ void Pcsx2Config::RecompilerOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(EnableVU1);
 	SettingsWrapBitBool(EnableFastmem);
 	SettingsWrapBitBool(PauseOnTLBMiss);
+	SettingsWrapBitBool(EnableVUProgramCache);
 
 	SettingsWrapBitBool(vu0Overflow);
 	SettingsWrapBitBool(vu0ExtraOverflow);
@@ -561,6 +563,8 @@ bool Pcsx2Config::GSOptions::operator==(const GSOptions& right) const
 	return (
 		OpEqu(SynchronousMTGS) &&
 		OpEqu(VsyncQueueSize) &&
+		OpEqu(MTGSRingLimit) &&
+		OpEqu(MTVURingLimit) &&
 
 		OpEqu(FrameLimitEnable) &&
 
@@ -685,6 +689,10 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapEntry(SynchronousMTGS);
 #endif
 	SettingsWrapEntry(VsyncQueueSize);
+	SettingsWrapEntry(MTGSRingLimit);
+	SettingsWrapEntry(MTVURingLimit);
+	MTGSRingLimit = std::clamp(MTGSRingLimit, 10, 100);
+	MTVURingLimit = std::clamp(MTVURingLimit, 10, 100);
 
 	SettingsWrapEntry(FrameLimitEnable);
 	wrap.EnumEntry(CURRENT_SETTINGS_SECTION, "VsyncEnable", VsyncEnable, NULL, VsyncEnable);
@@ -70,6 +70,15 @@ static float s_vu_thread_time = 0.0f;
 static float s_capture_thread_usage = 0.0f;
 static float s_capture_thread_time = 0.0f;
 
+struct RingBufferStats
+{
+	float usage = 0.0f;
+	u32 stalls = 0;
+	float stall_time = 0.0f;
+};
+static RingBufferStats s_gs_ring;
+static RingBufferStats s_vu_ring;
+
 static PerformanceMetrics::FrameTimeHistory s_frame_time_history;
 static u32 s_frame_time_history_pos = 0;
 
@@ -106,6 +115,8 @@ void PerformanceMetrics::Clear()
 	s_vu_thread_time = 0.0f;
 	s_capture_thread_usage = 0.0f;
 	s_capture_thread_time = 0.0f;
+	s_gs_ring = {};
+	s_vu_ring = {};
 
 	s_average_gpu_time = 0.0f;
 	s_gpu_usage = 0.0f;
@@ -140,6 +151,17 @@ void PerformanceMetrics::Reset()
 
 	for (GSSWThreadStats& stat : s_gs_sw_threads)
 		stat.last_cpu_time = stat.handle.GetCPUTime();
+
+	MTGS::ConsumeRingStats();
+	if (THREAD_VU1)
+		vu1Thread.ConsumeRingStats();
+}
+
+static void UpdateRingBufferStats(RingBufferStats& stats, const MTGS::RingStats& ring, u32 frames)
+{
+	stats.usage = (ring.size > 0) ? std::min(static_cast<float>(ring.peak_used) * 100.0f / static_cast<float>(ring.size), 100.0f) : 0.0f;
+	stats.stalls = ring.stalls;
+	stats.stall_time = static_cast<float>(Common::Timer::ConvertValueToMilliseconds(ring.stall_ticks)) / static_cast<float>(frames);
 }
 
 void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_skipping_present)
@@ -237,6 +259,12 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 		thread.time = static_cast<double>(delta) * time_divider;
 	}
 
+	UpdateRingBufferStats(s_gs_ring, MTGS::ConsumeRingStats(), s_frames_since_last_update);
+	if (THREAD_VU1)
+		UpdateRingBufferStats(s_vu_ring, vu1Thread.ConsumeRingStats(), s_frames_since_last_update);
+	else
+		s_vu_ring = {};
+
 	s_frames_since_last_update = 0;
 	s_unskipped_frames_since_last_update = 0;
 	s_presents_since_last_update = 0;
@@ -383,6 +411,36 @@ float PerformanceMetrics::GetGPUAverageTime()
 	return s_average_gpu_time;
 }
 
+float PerformanceMetrics::GetGSRingUsage()
+{
+	return s_gs_ring.usage;
+}
+
+u32 PerformanceMetrics::GetGSRingStalls()
+{
+	return s_gs_ring.stalls;
+}
+
+float PerformanceMetrics::GetGSRingStallTime()
+{
+	return s_gs_ring.stall_time;
+}
+
+float PerformanceMetrics::GetVURingUsage()
+{
+	return s_vu_ring.usage;
+}
+
+u32 PerformanceMetrics::GetVURingStalls()
+{
+	return s_vu_ring.stalls;
+}
+
+float PerformanceMetrics::GetVURingStallTime()
+{
+	return s_vu_ring.stall_time;
+}
+
 const PerformanceMetrics::FrameTimeHistory& PerformanceMetrics::GetFrameTimeHistory()
 {
 	return s_frame_time_history;
@@ -73,6 +73,14 @@ namespace PerformanceMetrics
 	float GetGPUUsage();
 	float GetGPUAverageTime();
 
+	/// Peak ring occupancy in percent, producer stall count, and stall time in milliseconds per frame.
+	float GetGSRingUsage();
+	u32 GetGSRingStalls();
+	float GetGSRingStallTime();
+	float GetVURingUsage();
+	u32 GetVURingStalls();
+	float GetVURingStallTime();
+
 	const FrameTimeHistory& GetFrameTimeHistory();
 	u32 GetFrameTimeHistoryPos();
 } // namespace PerformanceMetrics
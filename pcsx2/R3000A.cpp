@@ -28,6 +28,7 @@
 #include "IopDma.h"
 #include "CDVD/Ps1CD.h"
 #include "CDVD/CDVD.h"
+#include "EventQueue.h"
 
 using namespace R3000A;
 
@@ -46,6 +47,9 @@ static constexpr uint iopWaitCycles = 384; // Keep inline with EE wait cycle max
 
 bool iopEventTestIsActive = false;
 
+// Deadlines of the events in psxRegs.interrupt (see EventQueue).
+static EventQueue s_iopEventQueue;
+
 alignas(16) psxRegisters psxRegs;
 
 void psxReset()
@@ -59,6 +63,7 @@ void psxReset()
 	psxRegs.iopBreak = 0;
 	psxRegs.iopCycleEE = -1;
 	psxRegs.iopNextEventCycle = psxRegs.cycle + 4;
+	s_iopEventQueue.Clear();
 
 	psxHwReset();
 	PSXCLK = 36864000;
@@ -129,6 +134,20 @@ __fi int psxTestCycle( u32 startCycle, s32 delta )
 	return (int)(psxRegs.cycle - startCycle) >= delta;
 }
 
+static bool psxGetIntDeadline(u32 n, u32* deadline)
+{
+	if (!(psxRegs.interrupt & (1u << n)))
+		return false;
+
+	*deadline = psxRegs.sCycle[n] + psxRegs.eCycle[n];
+	return true;
+}
+
+void psxRebuildEventQueue()
+{
+	s_iopEventQueue.Rebuild(psxGetIntDeadline);
+}
+
 __fi void PSX_INT( IopEventId n, s32 ecycle )
 {
 	// 19 is CDVD read int, it's supposed to be high.
@@ -140,6 +159,8 @@ __fi void PSX_INT( IopEventId n, s32 ecycle )
 	psxRegs.sCycle[n] = psxRegs.cycle;
 	psxRegs.eCycle[n] = ecycle;
 
+	s_iopEventQueue.Schedule(n, psxRegs.sCycle[n] + psxRegs.eCycle[n], psxGetIntDeadline);
+
 	psxSetNextBranchDelta(ecycle);
 
 	const s32 iopDelta = (psxRegs.iopNextEventCycle - psxRegs.cycle) * 8;
@@ -228,9 +249,21 @@ __ri void iopEventTest()
 
 	if (psxRegs.interrupt)
 	{
-		iopEventTestIsActive = true;
-		_psxTestInterrupts();
-		iopEventTestIsActive = false;
+		u32 deadline;
+		const bool queued = s_iopEventQueue.Peek(&deadline, psxGetIntDeadline);
+		if (!queued)
+			psxRebuildEventQueue();
+
+		if (!queued || psxTestCycle(deadline, 0))
+		{
+			iopEventTestIsActive = true;
+			_psxTestInterrupts();
+			iopEventTestIsActive = false;
+		}
+		else
+		{
+			psxSetNextBranch(deadline, 0);
+		}
 	}
 
 	if ((psxHu32(0x1078) != 0) && ((psxHu32(0x1070) & psxHu32(0x1074)) != 0))
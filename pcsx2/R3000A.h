@@ -207,6 +207,7 @@ extern R3000Acpu psxRec;
 extern void psxReset();
 extern void psxException(u32 code, u32 step);
 extern void iopEventTest();
+extern void psxRebuildEventQueue();
 extern void psxMemReset();
 
 int psxIsBreakpointNeeded(u32 addr);
@@ -24,6 +24,7 @@
 #include "ps2/pgif.h" // pgif init
 #include "VUmicro.h"
 #include "COP0.h"
+#include "Cache.h"
 #include "MTVU.h"
 #include "VMManager.h"
 
@@ -40,6 +41,7 @@
 #include "DebugTools/MIPSAnalyst.h"
 #include "DebugTools/SymbolMap.h"
 #include "R5900OpcodeTables.h"
+#include "EventQueue.h"
 
 using namespace R5900;	// for R5900 disasm tools
 
@@ -56,6 +58,10 @@ static constexpr uint eeWaitCycles = 3072;
 bool eeEventTestIsActive = false;
 EE_intProcessStatus eeRunInterruptScan = INT_NOT_RUNNING;
 
+// Deadlines of the events in cpuRegs.interrupt, so the event test only walks the
+// interrupt handlers once one of them is actually due.
+static EventQueue s_eeEventQueue;
+
 u32 g_eeloadMain = 0, g_eeloadExec = 0, g_osdsys_str = 0;
 
 /* I don't know how much space for args there is in the memory block used for args in full boot mode,
@@ -76,6 +82,7 @@ void cpuReset()
 	std::memset(&cpuRegs, 0, sizeof(cpuRegs));
 	std::memset(&fpuRegs, 0, sizeof(fpuRegs));
 	std::memset(&tlb, 0, sizeof(tlb));
+	resetCache();
 
 	cpuRegs.pc				= 0xbfc00000; //set pc reg to stack
 	cpuRegs.CP0.n.Config	= 0x440;
@@ -85,6 +92,7 @@ void cpuReset()
 	fpuRegs.fprc[31]		= 0x01000001; // fpu Status/Control
 
 	cpuRegs.nextEventCycle = cpuRegs.cycle + 4;
+	s_eeEventQueue.Clear();
 	EEsCycle = 0;
 	EEoCycle = cpuRegs.cycle;
 
@@ -242,6 +250,25 @@ __fi int cpuTestCycle( u32 startCycle, s32 delta )
 	return (int)(cpuRegs.cycle - startCycle) >= delta;
 }
 
+static bool cpuGetIntDeadline(u32 n, u32* deadline)
+{
+	if (!(cpuRegs.interrupt & (1u << n)))
+		return false;
+
+	*deadline = cpuRegs.sCycle[n] + cpuRegs.eCycle[n];
+	return true;
+}
+
+void cpuRebuildEventQueue()
+{
+	s_eeEventQueue.Rebuild(cpuGetIntDeadline);
+}
+
+static __fi void cpuQueueInt(u32 n)
+{
+	s_eeEventQueue.Schedule(n, cpuRegs.sCycle[n] + cpuRegs.eCycle[n], cpuGetIntDeadline);
+}
+
 // tells the EE to run the branch test the next time it gets a chance.
 __fi void cpuSetEvent()
 {
@@ -415,7 +442,19 @@ __fi void _cpuEventTest_Shared()
 				;
 		}
 		else
-			_cpuTestInterrupts();
+		{
+			u32 deadline;
+			if (!s_eeEventQueue.Peek(&deadline, cpuGetIntDeadline))
+			{
+				// Pending bits the queue doesn't know about; shouldn't happen, but stay safe.
+				cpuRebuildEventQueue();
+				_cpuTestInterrupts();
+			}
+			else if (CHECK_INSTANTDMAHACK || cpuTestCycle(deadline, 0))
+				_cpuTestInterrupts();
+			else
+				cpuSetNextEvent(deadline, 0);
+		}
 	}
 
 	// ---- IOP -------------
@@ -546,6 +585,7 @@ __fi void CPU_INT( EE_EventType n, s32 ecycle)
 		cpuRegs.interrupt |= 1 << n;
 		cpuRegs.sCycle[n] = cpuRegs.cycle;
 		cpuRegs.eCycle[n] = 0;
+		cpuQueueInt(n);
 		return;
 	}
 
@@ -558,6 +598,7 @@ __fi void CPU_INT( EE_EventType n, s32 ecycle)
 	cpuRegs.interrupt |= 1 << n;
 	cpuRegs.sCycle[n] = cpuRegs.cycle;
 	cpuRegs.eCycle[n] = ecycle;
+	cpuQueueInt(n);
 
 	// Interrupt is happening soon: make sure both EE and IOP are aware.
 
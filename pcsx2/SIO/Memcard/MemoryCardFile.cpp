@@ -22,10 +22,14 @@
 
 #include "common/FileSystem.h"
 #include "common/Path.h"
+#include "common/Threading.h"
 #include "common/StringUtil.h"
 
 #include <array>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "System.h"
 #include "Config.h"
@@ -46,6 +50,19 @@ static constexpr int MC2_ERASE_SIZE = 528 * 16;
 
 static const char* s_folder_mem_card_id_file = "_pcsx2_superblock";
 
+// Writes are coalesced until the card has been idle for this long, so a save which touches
+// many pages is written (and journaled) in one go.
+static constexpr auto MCD_FLUSH_DELAY = std::chrono::milliseconds(250);
+
+// How long to back off for before retrying a flush which failed.
+static constexpr auto MCD_FLUSH_RETRY_DELAY = std::chrono::seconds(2);
+
+// Minimum time between "saved to storage" notifications.
+static constexpr auto MCD_SAVE_OSD_INTERVAL = std::chrono::seconds(5);
+
+static constexpr u32 MCD_JOURNAL_MAGIC = 0x4C4E524A; // JRNL
+static constexpr u32 MCD_JOURNAL_COMMIT = 0x54494D43; // CMIT
+
 bool FileMcd_Open = false;
 
 // ECC code ported from mymc
@@ -165,18 +182,40 @@ static bool ConvertRAWtoNoECC(const char* file_in, const char* file_out)
 // --------------------------------------------------------------------------------------
 //  FileMemoryCard
 // --------------------------------------------------------------------------------------
-// Provides thread-safe direct file IO mapping.
+// Keeps the whole card file in memory, so reads and writes never touch the disk on the
+// emulation thread. Modified erase blocks are written back by a flush thread, through a
+// journal next to the card file which is replayed on open if we crashed halfway.
 //
 class FileMemoryCard
 {
 protected:
+	struct DirtyBlock
+	{
+		uint slot;
+		u32 offset;
+		std::vector<u8> data;
+	};
+
 	std::FILE* m_file[8] = {};
 	std::string m_filenames[8] = {};
+	std::FILE* m_journal[8] = {};
+	std::string m_journal_filenames[8] = {};
+	std::vector<u8> m_image[8];
+	std::vector<bool> m_dirty[8];
+	u32 m_offset[8] = {};
 	std::vector<u8> m_currentdata;
 	u64 m_chksum[8] = {};
 	bool m_ispsx[8] = {};
 	u32 m_chkaddr = 0;
 
+	std::thread m_flush_thread;
+	std::mutex m_flush_mutex;
+	std::condition_variable m_flush_cv;
+	std::chrono::steady_clock::time_point m_last_write;
+	std::chrono::steady_clock::time_point m_last_save_osd;
+	bool m_flush_pending = false;
+	bool m_flush_shutdown = false;
+
 public:
 	FileMemoryCard();
 	~FileMemoryCard();
@@ -196,8 +235,14 @@ public:
 	u64 GetCRC(uint slot);
 
 protected:
-	bool Seek(std::FILE* f, u32 adr);
 	bool Create(const char* mcdFile, uint sizeInMB);
+
+	u8* GetImagePointer(uint slot, u32 adr, u32 size);
+	void MarkDirty(uint slot, u32 pos, u32 size);
+	std::vector<DirtyBlock> TakeDirtyBlocks();
+	u32 WriteBlocks(const std::vector<DirtyBlock>& blocks);
+	void ReplayJournal(uint slot);
+	void FlushThreadEntryPoint();
 };
 
 uint FileMcd_GetMtapPort(uint slot)
@@ -354,35 +399,104 @@ void FileMemoryCard::Open()
 #endif
 			);
 		}
-		else // Load checksum
+		else // Load image and checksum
 		{
+			m_journal_filenames[slot] = (StringUtil::EndsWith(fname, ".bin") ? fname + "x" : fname) + ".journal";
 			m_filenames[slot] = std::move(fname);
-			m_ispsx[slot] = FileSystem::FSize64(m_file[slot]) == 0x20000;
+			ReplayJournal(slot);
+
+			// Kept open and truncated after each flush, rather than recreated every time.
+			m_journal[slot] = FileSystem::OpenCFile(m_journal_filenames[slot].c_str(), "w+b");
+			if (!m_journal[slot])
+				Console.Error("(FileMcd) Failed to open journal %s", m_journal_filenames[slot].c_str());
+
+			std::optional<std::vector<u8>> image;
+			if (FileSystem::FSeek64(m_file[slot], 0, SEEK_SET) == 0)
+				image = FileSystem::ReadBinaryFile(m_file[slot]);
+			if (!image.has_value())
+			{
+				Host::ReportFormattedErrorAsync("Memory Card", "Error reading memcard.\n");
+				std::fclose(m_file[slot]);
+				m_file[slot] = nullptr;
+				m_filenames[slot] = {};
+				continue;
+			}
+
+			m_image[slot] = std::move(image.value());
+			m_dirty[slot].assign((m_image[slot].size() + MC2_ERASE_SIZE - 1) / MC2_ERASE_SIZE, false);
+
+			// If anyone knows why this filesize logic is here (it appears to be related to legacy PSX
+			// cards, perhaps hacked support for some special emulator-specific memcard formats that
+			// had header info?), then please replace this comment with something useful.  Thanks!  -- air
+			const size_t size = m_image[slot].size();
+			m_offset[slot] = (size == MCD_SIZE + 64) ? 64 : ((size == MCD_SIZE + 3904) ? 3904 : 0);
+			m_ispsx[slot] = size == 0x20000;
 			m_chkaddr = 0x210;
 
-			if (!m_ispsx[slot] && FileSystem::FSeek64(m_file[slot], m_chkaddr, SEEK_SET) == 0)
+			if (!m_ispsx[slot])
 			{
-				const size_t read_result = std::fread(&m_chksum[slot], sizeof(m_chksum[slot]), 1, m_file[slot]);
-				if (read_result == 0)
+				if (size >= m_chkaddr + sizeof(m_chksum[slot]))
+					std::memcpy(&m_chksum[slot], &m_image[slot][m_chkaddr], sizeof(m_chksum[slot]));
+				else
 					Host::ReportFormattedErrorAsync("Memory Card", "Error reading memcard.\n");
 			}
 		}
 	}
+
+	// Nothing to flush if no card opened.
+	if (std::none_of(std::begin(m_file), std::end(m_file), [](std::FILE* fp) { return fp != nullptr; }))
+		return;
+
+	m_flush_shutdown = false;
+	m_flush_pending = false;
+	m_flush_thread = std::thread(&FileMemoryCard::FlushThreadEntryPoint, this);
 }
 
 void FileMemoryCard::Close()
 {
+	if (m_flush_thread.joinable())
+	{
+		{
+			std::unique_lock lock(m_flush_mutex);
+			m_flush_shutdown = true;
+			m_flush_cv.notify_one();
+		}
+
+		m_flush_thread.join();
+	}
+
+	// Store checksums, and write back anything the flush thread didn't get to
+	for (int slot = 0; slot < 8; ++slot)
+	{
+		if (m_file[slot] && !m_ispsx[slot] && m_image[slot].size() >= m_chkaddr + sizeof(m_chksum[slot]))
+		{
+			std::memcpy(&m_image[slot][m_chkaddr], &m_chksum[slot], sizeof(m_chksum[slot]));
+			MarkDirty(slot, m_chkaddr, sizeof(m_chksum[slot]));
+		}
+	}
+
+	WriteBlocks(TakeDirtyBlocks());
+
 	for (int slot = 0; slot < 8; ++slot)
 	{
 		if (!m_file[slot])
 			continue;
 
-		// Store checksum
-		if (!m_ispsx[slot] && FileSystem::FSeek64(m_file[slot], m_chkaddr, SEEK_SET) == 0)
-			std::fwrite(&m_chksum[slot], sizeof(m_chksum[slot]), 1, m_file[slot]);
-
 		std::fclose(m_file[slot]);
 		m_file[slot] = nullptr;
+		m_image[slot] = {};
+		m_dirty[slot] = {};
+
+		// A journal which is still holding writes gets replayed on the next open.
+		if (m_journal[slot])
+		{
+			const bool empty = FileSystem::FSize64(m_journal[slot]) == 0;
+			std::fclose(m_journal[slot]);
+			m_journal[slot] = nullptr;
+			if (empty)
+				FileSystem::DeleteFilePath(m_journal_filenames[slot].c_str());
+		}
+		m_journal_filenames[slot] = {};
 
 		if (StringUtil::EndsWith(m_filenames[slot], ".bin"))
 		{
@@ -395,27 +509,247 @@ void FileMemoryCard::Close()
 	}
 }
 
-// Returns FALSE if the seek failed (is outside the bounds of the file).
-bool FileMemoryCard::Seek(std::FILE* f, u32 adr)
+// Returns nullptr if the range is outside of the card (where seeking/reading the file would fail).
+u8* FileMemoryCard::GetImagePointer(uint slot, u32 adr, u32 size)
 {
-	const s64 size = FileSystem::FSize64(f);
+	const u64 pos = static_cast<u64>(adr) + m_offset[slot];
+	if (pos + size > m_image[slot].size())
+		return nullptr;
 
-	// If anyone knows why this filesize logic is here (it appears to be related to legacy PSX
-	// cards, perhaps hacked support for some special emulator-specific memcard formats that
-	// had header info?), then please replace this comment with something useful.  Thanks!  -- air
+	return &m_image[slot][pos];
+}
 
-	u32 offset = 0;
+// Caller must hold m_flush_mutex if the flush thread is running.
+void FileMemoryCard::MarkDirty(uint slot, u32 pos, u32 size)
+{
+	const u32 first = pos / MC2_ERASE_SIZE;
+	const u32 last = (pos + size - 1) / MC2_ERASE_SIZE;
+	for (u32 i = first; i <= last; i++)
+		m_dirty[slot][i] = true;
+}
 
-	if (size == MCD_SIZE + 64)
-		offset = 64;
-	else if (size == MCD_SIZE + 3904)
-		offset = 3904;
-	else
+std::vector<FileMemoryCard::DirtyBlock> FileMemoryCard::TakeDirtyBlocks()
+{
+	std::vector<DirtyBlock> blocks;
+	for (uint slot = 0; slot < 8; slot++)
 	{
-		// perform sanity checks here?
+		for (u32 i = 0; i < static_cast<u32>(m_dirty[slot].size()); i++)
+		{
+			if (!m_dirty[slot][i])
+				continue;
+
+			const u32 offset = i * MC2_ERASE_SIZE;
+			const u32 size = std::min<u32>(MC2_ERASE_SIZE, static_cast<u32>(m_image[slot].size()) - offset);
+			blocks.push_back({slot, offset, std::vector<u8>(&m_image[slot][offset], &m_image[slot][offset] + size)});
+			m_dirty[slot][i] = false;
+		}
 	}
 
-	return (FileSystem::FSeek64(f, adr + offset, SEEK_SET) == 0);
+	return blocks;
+}
+
+// Writes the blocks to the journal of each card, then to the card itself. The journal only
+// counts once its commit marker is written, so a crash leaves either the old card with an
+// incomplete journal (ignored), or a complete journal to replay on the next open.
+// Returns a mask of the slots which failed to write.
+u32 FileMemoryCard::WriteBlocks(const std::vector<DirtyBlock>& blocks)
+{
+	u32 failed_slots = 0;
+
+	for (uint slot = 0; slot < 8; slot++)
+	{
+		const auto has_slot = [slot](const DirtyBlock& block) { return block.slot == slot; };
+		const u32 count = static_cast<u32>(std::count_if(blocks.begin(), blocks.end(), has_slot));
+		if (count == 0 || !m_file[slot])
+			continue;
+
+		// Truncate first, a journal left over from a failed write must not leave a stale tail behind.
+		std::FILE* const fp = m_journal[slot];
+		bool journaled = fp && FileSystem::FTruncate64(fp, 0) == 0 && FileSystem::FSeek64(fp, 0, SEEK_SET) == 0;
+		if (journaled)
+		{
+			journaled = std::fwrite(&MCD_JOURNAL_MAGIC, sizeof(MCD_JOURNAL_MAGIC), 1, fp) == 1 &&
+						std::fwrite(&count, sizeof(count), 1, fp) == 1;
+
+			for (const DirtyBlock& block : blocks)
+			{
+				if (!journaled || block.slot != slot)
+					continue;
+
+				const u32 size = static_cast<u32>(block.data.size());
+				journaled = std::fwrite(&block.offset, sizeof(block.offset), 1, fp) == 1 &&
+							std::fwrite(&size, sizeof(size), 1, fp) == 1 &&
+							std::fwrite(block.data.data(), size, 1, fp) == 1;
+			}
+
+			journaled = journaled && std::fwrite(&MCD_JOURNAL_COMMIT, sizeof(MCD_JOURNAL_COMMIT), 1, fp) == 1 &&
+						std::fflush(fp) == 0;
+		}
+
+		if (!journaled)
+			Console.Error("(FileMcd) Failed to write journal %s", m_journal_filenames[slot].c_str());
+
+		bool written = true;
+		for (const DirtyBlock& block : blocks)
+		{
+			if (block.slot != slot)
+				continue;
+
+			written = written && FileSystem::FSeek64(m_file[slot], block.offset, SEEK_SET) == 0 &&
+					  std::fwrite(block.data.data(), block.data.size(), 1, m_file[slot]) == 1;
+		}
+
+		written = written && std::fflush(m_file[slot]) == 0;
+		if (written)
+		{
+			if (fp)
+				FileSystem::FTruncate64(fp, 0);
+		}
+		else
+		{
+			Console.Error("(FileMcd) Failed to write memory card %s", m_filenames[slot].c_str());
+			failed_slots |= 1u << slot;
+		}
+	}
+
+	return failed_slots;
+}
+
+void FileMemoryCard::ReplayJournal(uint slot)
+{
+	const char* path = m_journal_filenames[slot].c_str();
+	if (!FileSystem::FileExists(path))
+		return;
+
+	const std::optional<std::vector<u8>> journal = FileSystem::ReadBinaryFile(path);
+	const size_t size = journal.has_value() ? journal->size() : 0;
+	const u8* data = journal.has_value() ? journal->data() : nullptr;
+
+	u32 magic = 0, count = 0;
+	size_t pos = sizeof(magic) + sizeof(count);
+	bool valid = size >= pos + sizeof(MCD_JOURNAL_COMMIT);
+	if (valid)
+	{
+		std::memcpy(&magic, data, sizeof(magic));
+		std::memcpy(&count, data + sizeof(magic), sizeof(count));
+		valid = magic == MCD_JOURNAL_MAGIC;
+	}
+
+	// check the whole journal made it to disk before touching the card
+	struct Record
+	{
+		size_t pos;
+		u32 offset;
+		u32 length;
+	};
+	std::vector<Record> records;
+	for (u32 i = 0; valid && i < count; i++)
+	{
+		u32 offset, length;
+		valid = size >= pos + sizeof(offset) + sizeof(length);
+		if (!valid)
+			break;
+
+		std::memcpy(&offset, data + pos, sizeof(offset));
+		std::memcpy(&length, data + pos + sizeof(offset), sizeof(length));
+		pos += sizeof(offset) + sizeof(length);
+
+		valid = size >= pos + length;
+		records.push_back({pos, offset, length});
+		pos += length;
+	}
+
+	u32 commit = 0;
+	if (valid && size >= pos + sizeof(commit))
+		std::memcpy(&commit, data + pos, sizeof(commit));
+
+	if (commit == MCD_JOURNAL_COMMIT)
+	{
+		Console.Warning("(FileMcd) Replaying %u interrupted writes to %s", count, m_filenames[slot].c_str());
+
+		for (const Record& record : records)
+		{
+			if (FileSystem::FSeek64(m_file[slot], record.offset, SEEK_SET) != 0 ||
+				std::fwrite(data + record.pos, record.length, 1, m_file[slot]) != 1)
+			{
+				Console.Error("(FileMcd) Failed to replay journal %s", path);
+				return;
+			}
+		}
+
+		std::fflush(m_file[slot]);
+	}
+
+	FileSystem::DeleteFilePath(path);
+}
+
+void FileMemoryCard::FlushThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("Memory Card Flush");
+
+	std::unique_lock lock(m_flush_mutex);
+	for (;;)
+	{
+		m_flush_cv.wait(lock, [this]() { return m_flush_pending || m_flush_shutdown; });
+		if (m_flush_shutdown)
+			break;
+
+		// wait for the game to stop writing
+		while (!m_flush_shutdown && std::chrono::steady_clock::now() < m_last_write + MCD_FLUSH_DELAY)
+			m_flush_cv.wait_until(lock, m_last_write + MCD_FLUSH_DELAY);
+
+		m_flush_pending = false;
+		const std::vector<DirtyBlock> blocks = TakeDirtyBlocks();
+
+		lock.unlock();
+		const u32 failed_slots = WriteBlocks(blocks);
+
+		u32 written_slots = 0;
+		for (const DirtyBlock& block : blocks)
+			written_slots |= 1u << block.slot;
+		written_slots &= ~failed_slots;
+
+		const auto now = std::chrono::steady_clock::now();
+		const bool show_saved = written_slots != 0 && (now - m_last_save_osd) > MCD_SAVE_OSD_INTERVAL;
+		if (show_saved)
+			m_last_save_osd = now;
+
+		for (uint slot = 0; slot < 8; slot++)
+		{
+			if (show_saved && (written_slots & (1u << slot)))
+			{
+				Host::AddIconOSDMessage(fmt::format("MemoryCardSave{}", slot), ICON_FA_SD_CARD,
+					fmt::format(TRANSLATE_FS("MemoryCard", "Memory Card '{}' was saved to storage."),
+						Path::GetFileName(m_filenames[slot])),
+					Host::OSD_INFO_DURATION);
+			}
+			else if (failed_slots & (1u << slot))
+			{
+				Host::AddIconOSDMessage(fmt::format("MemoryCardSave{}", slot), ICON_FA_EXCLAMATION_TRIANGLE,
+					fmt::format(TRANSLATE_FS("MemoryCard", "Failed to save Memory Card '{}' to storage, retrying."),
+						Path::GetFileName(m_filenames[slot])),
+					Host::OSD_ERROR_DURATION);
+			}
+		}
+
+		lock.lock();
+
+		// Put the failed blocks back, and try again once the disk has had a chance to recover.
+		if (failed_slots != 0)
+		{
+			for (const DirtyBlock& block : blocks)
+			{
+				if (failed_slots & (1u << block.slot))
+					MarkDirty(block.slot, block.offset, static_cast<u32>(block.data.size()));
+			}
+
+			m_flush_pending = true;
+			const auto retry_time = std::chrono::steady_clock::now() + MCD_FLUSH_RETRY_DELAY;
+			m_flush_cv.wait_until(lock, retry_time, [this, retry_time]() {
+				return m_flush_shutdown || std::chrono::steady_clock::now() >= retry_time;
+			});
+		}
+	}
 }
 
 // returns FALSE if an error occurred (either permission denied or disk full)
@@ -452,7 +786,7 @@ void FileMemoryCard::GetSizeInfo(uint slot, McdSizeInfo& outways)
 	outways.Xor = 18; // 0x12, XOR 02 00 00 10
 
 	if (pxAssert(m_file[slot]))
-		outways.McdSizeInSectors = static_cast<u32>(FileSystem::FSize64(m_file[slot])) / (outways.SectorSize + outways.EraseBlockSizeInSectors);
+		outways.McdSizeInSectors = static_cast<u32>(m_image[slot].size()) / (outways.SectorSize + outways.EraseBlockSizeInSectors);
 	else
 		outways.McdSizeInSectors = 0x4000;
 
@@ -474,9 +808,12 @@ s32 FileMemoryCard::Read(uint slot, u8* dest, u32 adr, int size)
 		memset(dest, 0, size);
 		return 1;
 	}
-	if (!Seek(mcfp, adr))
+	const u8* src = GetImagePointer(slot, adr, size);
+	if (!src)
 		return 0;
-	return std::fread(dest, size, 1, mcfp) == 1;
+
+	std::memcpy(dest, src, size);
+	return 1;
 }
 
 s32 FileMemoryCard::Save(uint slot, const u8* src, u32 adr, int size)
@@ -498,14 +835,13 @@ s32 FileMemoryCard::Save(uint slot, const u8* src, u32 adr, int size)
 	}
 	else
 	{
-		if (!Seek(mcfp, adr))
+		const u8* current = GetImagePointer(slot, adr, size);
+		if (!current)
 			return 0;
 		if (static_cast<int>(m_currentdata.size()) < size)
 			m_currentdata.resize(size);
 
-		const size_t read_result = std::fread(m_currentdata.data(), size, 1, mcfp);
-		if (read_result == 0)
-			Host::ReportFormattedErrorAsync("Memory Card", "Error reading memcard.\n");
+		std::memcpy(m_currentdata.data(), current, size);
 
 		for (int i = 0; i < size; i++)
 		{
@@ -527,26 +863,21 @@ s32 FileMemoryCard::Save(uint slot, const u8* src, u32 adr, int size)
 		}
 	}
 
-	if (!Seek(mcfp, adr))
+	u8* dest = GetImagePointer(slot, adr, size);
+	if (!dest)
 		return 0;
 
-	if (std::fwrite(m_currentdata.data(), size, 1, mcfp) == 1)
 	{
-		static auto last = std::chrono::time_point<std::chrono::system_clock>();
-
-		std::chrono::duration<float> elapsed = std::chrono::system_clock::now() - last;
-		if (elapsed > std::chrono::seconds(5))
-		{
-			Host::AddIconOSDMessage(fmt::format("MemoryCardSave{}", slot), ICON_FA_SD_CARD,
-				fmt::format(TRANSLATE_FS("MemoryCard", "Memory Card '{}' was saved to storage."),
-					Path::GetFileName(m_filenames[slot])),
-				Host::OSD_INFO_DURATION);
-			last = std::chrono::system_clock::now();
-		}
-		return 1;
+		std::unique_lock lock(m_flush_mutex);
+		std::memcpy(dest, m_currentdata.data(), size);
+		MarkDirty(slot, static_cast<u32>(dest - m_image[slot].data()), size);
+		m_last_write = std::chrono::steady_clock::now();
+		m_flush_pending = true;
+		m_flush_cv.notify_one();
 	}
 
-	return 0;
+	// The flush thread reports when it has actually reached storage.
+	return 1;
 }
 
 s32 FileMemoryCard::EraseBlock(uint slot, u32 adr)
@@ -558,12 +889,17 @@ s32 FileMemoryCard::EraseBlock(uint slot, u32 adr)
 		return 1;
 	}
 
-	if (!Seek(mcfp, adr))
+	u8* dest = GetImagePointer(slot, adr, MC2_ERASE_SIZE);
+	if (!dest)
 		return 0;
 
-	u8 buf[MC2_ERASE_SIZE];
-	std::memset(buf, 0xff, sizeof(buf));
-	return std::fwrite(buf, sizeof(buf), 1, mcfp) == 1;
+	std::unique_lock lock(m_flush_mutex);
+	std::memset(dest, 0xff, MC2_ERASE_SIZE);
+	MarkDirty(slot, static_cast<u32>(dest - m_image[slot].data()), MC2_ERASE_SIZE);
+	m_last_write = std::chrono::steady_clock::now();
+	m_flush_pending = true;
+	m_flush_cv.notify_one();
+	return 1;
 }
 
 u64 FileMemoryCard::GetCRC(uint slot)
@@ -576,25 +912,19 @@ u64 FileMemoryCard::GetCRC(uint slot)
 
 	if (m_ispsx[slot])
 	{
-		if (!Seek(mcfp, 0))
-			return 0;
+		// Process the file in 528 * 8 * 8 byte chunks (sector size), ignoring any remainder.
+		static constexpr u32 chunk_size = 528 * 8 * sizeof(u64);
 
-		const s64 mcfpsize = FileSystem::FSize64(mcfp);
-		if (mcfpsize < 0)
+		const u32 chunks = static_cast<u32>(m_image[slot].size()) / chunk_size;
+		const u8* data = GetImagePointer(slot, 0, chunks * chunk_size);
+		if (!data)
 			return 0;
 
-		// Process the file in 4k chunks.  Speeds things up significantly.
-
-		u64 buffer[528 * 8]; // use 528 (sector size), ensures even divisibility
-
-		const uint filesize = static_cast<uint>(mcfpsize) / sizeof(buffer);
-		for (uint i = filesize; i; --i)
+		for (u32 i = 0; i < chunks * chunk_size; i += sizeof(u64))
 		{
-			if (std::fread(buffer, sizeof(buffer), 1, mcfp) != 1)
-				return 0;
-
-			for (uint t = 0; t < std::size(buffer); ++t)
-				retval ^= buffer[t];
+			u64 value;
+			std::memcpy(&value, data + i, sizeof(value));
+			retval ^= value;
 		}
 	}
 	else
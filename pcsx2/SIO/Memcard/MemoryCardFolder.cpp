@@ -137,10 +137,10 @@ void FolderMemoryCard::InitializeInternalData()
 	memset(&m_fat, 0xFF, sizeof(m_fat));
 	memset(&m_backupBlock1, 0xFF, sizeof(m_backupBlock1));
 	memset(&m_backupBlock2, 0xFF, sizeof(m_backupBlock2));
-	m_cache.clear();
-	m_oldDataCache.clear();
+	m_cache.Clear();
+	m_oldDataCache.Clear();
 	m_lastAccessedFile.CloseAll();
-	m_fileMetadataQuickAccess.clear();
+	m_fileMetadataQuickAccess.Clear();
 	m_timeLastWritten = 0;
 	m_isEnabled = false;
 	m_framesUntilFlush = 0;
@@ -224,10 +224,10 @@ void FolderMemoryCard::Close(bool flush)
 		Flush();
 	}
 
-	m_cache.clear();
-	m_oldDataCache.clear();
+	m_cache.Clear();
+	m_oldDataCache.Clear();
 	m_lastAccessedFile.CloseAll();
-	m_fileMetadataQuickAccess.clear();
+	m_fileMetadataQuickAccess.Clear();
 	m_isEnabled = false;
 }
 
@@ -283,8 +283,10 @@ void FolderMemoryCard::LoadMemoryCardData(const u32 sizeInClusters, const bool e
 
 		CreateFat();
 		CreateRootDir();
+		LoadIndexCache();
 		MemoryCardFileEntry* const rootDirEntry = &m_fileEntryDict[m_superBlock.data.rootdir_cluster].entries[0];
 		AddFolder(rootDirEntry, m_folderName, nullptr, enableFiltering, filter);
+		SaveIndexCache();
 
 
 #ifdef DEBUG_WRITE_FOLDER_CARD_IN_MEMORY_TO_FILE_ON_CHANGE
@@ -482,6 +484,10 @@ bool FolderMemoryCard::AddFolder(MemoryCardFileEntry* const dirEntry, const std:
 			}
 		}
 
+		// check for metadata folders once instead of trying to open a metadata file for every entry
+		const bool hasFileMetadata = FileSystem::DirectoryExists(Path::Combine(dirPath, "_pcsx2_meta").c_str());
+		const bool hasDirMetadata = FileSystem::DirectoryExists(Path::Combine(dirPath, "_pcsx2_meta_directory").c_str());
+
 		int entryNumber = 2; // include . and ..
 		for (const auto& file : GetOrderedFiles(dirPath))
 		{
@@ -492,7 +498,7 @@ bool FolderMemoryCard::AddFolder(MemoryCardFileEntry* const dirEntry, const std:
 				{
 					continue;
 				}
-				if (AddFile(dirEntry, dirPath, file, parent))
+				if (AddFile(dirEntry, dirPath, file, parent, hasFileMetadata))
 				{
 					++entryNumber;
 				}
@@ -524,7 +530,7 @@ bool FolderMemoryCard::AddFolder(MemoryCardFileEntry* const dirEntry, const std:
 
 				// set metadata
 				const std::string metaFileName(Path::Combine(Path::Combine(dirPath, "_pcsx2_meta_directory"), file.m_fileName));
-				if (auto metaFile = FileSystem::OpenManagedCFile(metaFileName.c_str(), "rb"); metaFile)
+				if (auto metaFile = hasDirMetadata ? FileSystem::OpenManagedCFile(metaFileName.c_str(), "rb") : nullptr; metaFile)
 				{
 					if (std::fread(&newDirEntry->entry.raw, 1, sizeof(newDirEntry->entry.raw), metaFile.get()) < 0x60)
 					{
@@ -571,88 +577,74 @@ bool FolderMemoryCard::AddFolder(MemoryCardFileEntry* const dirEntry, const std:
 	return false;
 }
 
-bool FolderMemoryCard::AddFile(MemoryCardFileEntry* const dirEntry, const std::string& dirPath, const EnumeratedFileEntry& fileEntry, MemoryCardFileMetadataReference* parent)
+bool FolderMemoryCard::AddFile(MemoryCardFileEntry* const dirEntry, const std::string& dirPath, const EnumeratedFileEntry& fileEntry, MemoryCardFileMetadataReference* parent, const bool hasMetadata)
 {
 	const std::string filePath(Path::Combine(dirPath, fileEntry.m_fileName));
 	pxAssertMsg(StringUtil::StartsWith(filePath, m_folderName.c_str()), "Full file path starts with MC folder path");
 	const std::string relativeFilePath(filePath.substr(m_folderName.length() + 1));
 
-	if (auto file = FileSystem::OpenManagedCFile(filePath.c_str(), "rb"); file)
+	// make sure we have enough space on the memcard to hold the data
+	// the size comes from the directory listing, file contents are only opened once they're accessed
+	const u32 clusterSize = m_superBlock.data.pages_per_cluster * m_superBlock.data.page_len;
+	const u32 filesize = static_cast<u32>(std::clamp<s64>(fileEntry.m_size, 0, std::numeric_limits<u32>::max()));
+	const u32 countClusters = (filesize % clusterSize) != 0 ? (filesize / clusterSize + 1) : (filesize / clusterSize);
+	const u32 newNeededClusters = (dirEntry->entry.data.length % 2) == 0 ? countClusters + 1 : countClusters;
+	if (newNeededClusters > GetAmountFreeDataClusters())
 	{
-		// make sure we have enough space on the memcard to hold the data
-		const u32 clusterSize = m_superBlock.data.pages_per_cluster * m_superBlock.data.page_len;
-		const u32 filesize = static_cast<u32>(std::clamp<s64>(FileSystem::FSize64(file.get()), 0, std::numeric_limits<u32>::max()));
-		const u32 countClusters = (filesize % clusterSize) != 0 ? (filesize / clusterSize + 1) : (filesize / clusterSize);
-		const u32 newNeededClusters = (dirEntry->entry.data.length % 2) == 0 ? countClusters + 1 : countClusters;
-		if (newNeededClusters > GetAmountFreeDataClusters())
-		{
-			Console.Warning(GetCardFullMessage(relativeFilePath));
-			return false;
-		}
+		Console.Warning(GetCardFullMessage(relativeFilePath));
+		return false;
+	}
 
-		MemoryCardFileEntry* newFileEntry = AppendFileEntryToDir(dirEntry);
+	MemoryCardFileEntry* newFileEntry = AppendFileEntryToDir(dirEntry);
 
-		// set file entry metadata
-		memset(newFileEntry->entry.raw, 0x00, sizeof(newFileEntry->entry.raw));
+	// set file entry metadata
+	memset(newFileEntry->entry.raw, 0x00, sizeof(newFileEntry->entry.raw));
 
-		std::string metaFileName(Path::Combine(Path::Combine(dirPath, "_pcsx2_meta"), fileEntry.m_fileName));
-		if (auto metaFile = FileSystem::OpenManagedCFile(metaFileName.c_str(), "rb"); metaFile)
-		{
-			size_t bytesRead = std::fread(&newFileEntry->entry.raw, 1, sizeof(newFileEntry->entry.raw), metaFile.get());
-			if (bytesRead < 0x60)
-			{
-				StringUtil::Strlcpy(reinterpret_cast<char*>(newFileEntry->entry.data.name), fileEntry.m_fileName.c_str(), sizeof(newFileEntry->entry.data.name));
-			}
-		}
-		else
+	std::string metaFileName(Path::Combine(Path::Combine(dirPath, "_pcsx2_meta"), fileEntry.m_fileName));
+	if (auto metaFile = hasMetadata ? FileSystem::OpenManagedCFile(metaFileName.c_str(), "rb") : nullptr; metaFile)
+	{
+		size_t bytesRead = std::fread(&newFileEntry->entry.raw, 1, sizeof(newFileEntry->entry.raw), metaFile.get());
+		if (bytesRead < 0x60)
 		{
-			newFileEntry->entry.data.mode = MemoryCardFileEntry::DefaultFileMode;
-			newFileEntry->entry.data.timeCreated = MemoryCardFileEntryDateTime::FromTime(fileEntry.m_timeCreated);
-			newFileEntry->entry.data.timeModified = MemoryCardFileEntryDateTime::FromTime(fileEntry.m_timeModified);
 			StringUtil::Strlcpy(reinterpret_cast<char*>(newFileEntry->entry.data.name), fileEntry.m_fileName.c_str(), sizeof(newFileEntry->entry.data.name));
 		}
+	}
+	else
+	{
+		newFileEntry->entry.data.mode = MemoryCardFileEntry::DefaultFileMode;
+		newFileEntry->entry.data.timeCreated = MemoryCardFileEntryDateTime::FromTime(fileEntry.m_timeCreated);
+		newFileEntry->entry.data.timeModified = MemoryCardFileEntryDateTime::FromTime(fileEntry.m_timeModified);
+		StringUtil::Strlcpy(reinterpret_cast<char*>(newFileEntry->entry.data.name), fileEntry.m_fileName.c_str(), sizeof(newFileEntry->entry.data.name));
+	}
 
-		newFileEntry->entry.data.length = filesize;
-		if (filesize != 0)
-		{
-			u32 fileDataStartingCluster = GetFreeDataCluster();
-			newFileEntry->entry.data.cluster = fileDataStartingCluster;
-
-			// mark the appropriate amount of clusters as used
-			u32 dataCluster = fileDataStartingCluster;
-			m_fat.data[0][0][dataCluster] = LastDataCluster | DataClusterInUseMask;
-			for (unsigned int i = 0; i < countClusters - 1; ++i)
-			{
-				u32 newCluster = GetFreeDataCluster();
-				m_fat.data[0][0][dataCluster] = newCluster | DataClusterInUseMask;
-				m_fat.data[0][0][newCluster] = LastDataCluster | DataClusterInUseMask;
-				dataCluster = newCluster;
-			}
-		}
-		else
-		{
-			newFileEntry->entry.data.cluster = MemoryCardFileEntry::EmptyFileCluster;
-		}
-
-		file.reset();
+	newFileEntry->entry.data.length = filesize;
+	if (filesize != 0)
+	{
+		u32 fileDataStartingCluster = GetFreeDataCluster();
+		newFileEntry->entry.data.cluster = fileDataStartingCluster;
 
-		MemoryCardFileMetadataReference* fileRef = AddFileEntryToMetadataQuickAccess(newFileEntry, parent);
-		if (fileRef != nullptr)
+		// mark the appropriate amount of clusters as used
+		u32 dataCluster = fileDataStartingCluster;
+		m_fat.data[0][0][dataCluster] = LastDataCluster | DataClusterInUseMask;
+		for (unsigned int i = 0; i < countClusters - 1; ++i)
 		{
-			// acquire a handle on the file so nothing else can change the file contents while the memory card is open
-			m_lastAccessedFile.ReOpen(m_folderName, fileRef);
+			u32 newCluster = GetFreeDataCluster();
+			m_fat.data[0][0][dataCluster] = newCluster | DataClusterInUseMask;
+			m_fat.data[0][0][newCluster] = LastDataCluster | DataClusterInUseMask;
+			dataCluster = newCluster;
 		}
-
-		// and finally, increase file count in the directory entry
-		dirEntry->entry.data.length++;
-
-		return true;
 	}
 	else
 	{
-		Console.WriteLn("(FolderMcd) Could not open file: %s", relativeFilePath.c_str());
-		return false;
+		newFileEntry->entry.data.cluster = MemoryCardFileEntry::EmptyFileCluster;
 	}
+
+	AddFileEntryToMetadataQuickAccess(newFileEntry, parent);
+
+	// and finally, increase file count in the directory entry
+	dirEntry->entry.data.length++;
+
+	return true;
 }
 
 u32 FolderMemoryCard::CalculateRequiredClustersOfDirectory(const std::string& dirPath) const
@@ -832,13 +824,12 @@ MemoryCardFileEntryCluster* FolderMemoryCard::GetFileEntryCluster(const u32 curr
 	}
 
 	// check subdirectories
-	auto it = m_fileEntryDict.find(currentCluster);
-	if (it != m_fileEntryDict.end())
+	if (const MemoryCardFileEntryCluster* entries = m_fileEntryDict.Find(currentCluster))
 	{
 		const u32 filesInThisCluster = std::min(fileCount, 2u);
 		for (unsigned int i = 0; i < filesInThisCluster; ++i)
 		{
-			const MemoryCardFileEntry* const entry = &it->second.entries[i];
+			const MemoryCardFileEntry* const entry = &entries->entries[i];
 			if (entry->IsValid() && entry->IsUsed() && entry->IsDir() && !entry->IsDotDir())
 			{
 				const u32 newFileCount = entry->entry.data.length;
@@ -925,11 +916,10 @@ bool FolderMemoryCard::ReadFromFile(u8* dest, u32 adr, u32 dataLength)
 	}
 
 	// figure out which file to read from
-	auto it = m_fileMetadataQuickAccess.find(fatCluster);
-	if (it != m_fileMetadataQuickAccess.end())
+	if (MemoryCardFileMetadataReference* fileRef = m_fileMetadataQuickAccess.Find(fatCluster))
 	{
-		const u32 clusterNumber = it->second.consecutiveCluster;
-		std::FILE* file = m_lastAccessedFile.ReOpen(m_folderName, &it->second);
+		const u32 clusterNumber = fileRef->consecutiveCluster;
+		std::FILE* file = m_lastAccessedFile.ReOpen(m_folderName, fileRef);
 		if (file)
 		{
 			const u32 clusterOffset = (page % 2) * PageSize + offset;
@@ -975,10 +965,9 @@ s32 FolderMemoryCard::Read(u8* dest, u32 adr, int size)
 		const u32 dataLength = std::min((u32)size, (u32)(PageSize - offset));
 
 		// if we have a cache for this page, just load from that
-		auto it = m_cache.find(page);
-		if (it != m_cache.end())
+		if (const MemoryCardPage* cachePage = m_cache.Find(page))
 		{
-			memcpy(dest, &it->second.raw[offset], dataLength);
+			memcpy(dest, &cachePage->raw[offset], dataLength);
 		}
 		else
 		{
@@ -1054,19 +1043,14 @@ s32 FolderMemoryCard::Save(const u8* src, u32 adr, int size)
 		const u32 dataLength = std::min((u32)size, PageSize - offset);
 
 		// if cache page has not yet been touched, fill it with the data from our memory card
-		auto it = m_cache.find(page);
-		MemoryCardPage* cachePage;
-		if (it == m_cache.end())
+		MemoryCardPage* cachePage = m_cache.Find(page);
+		if (!cachePage)
 		{
 			cachePage = &m_cache[page];
 			const u32 adrLoad = page * PageSizeRaw;
 			ReadDataWithoutCache(&cachePage->raw[0], adrLoad, PageSize);
 			memcpy(&m_oldDataCache[page].raw[0], &cachePage->raw[0], PageSize);
 		}
-		else
-		{
-			cachePage = &it->second;
-		}
 
 		// then just write to the cache
 		memcpy(&cachePage->raw[offset], src, dataLength);
@@ -1087,7 +1071,7 @@ void FolderMemoryCard::NextFrame()
 
 void FolderMemoryCard::Flush()
 {
-	if (m_cache.empty())
+	if (m_cache.Empty())
 	{
 		return;
 	}
@@ -1162,7 +1146,7 @@ void FolderMemoryCard::Flush()
 
 	m_lastAccessedFile.FlushAll();
 	m_lastAccessedFile.ClearMetadataWriteState();
-	m_oldDataCache.clear();
+	m_oldDataCache.Clear();
 
 	Console.WriteLn("(FolderMcd) Done! Took %.2f ms.", timeFlushStart.GetTimeMilliseconds());
 
@@ -1173,11 +1157,10 @@ void FolderMemoryCard::Flush()
 
 bool FolderMemoryCard::FlushPage(const u32 page)
 {
-	auto it = m_cache.find(page);
-	if (it != m_cache.end())
+	if (const MemoryCardPage* cachePage = m_cache.Find(page))
 	{
-		WriteWithoutCache(&it->second.raw[0], page * PageSizeRaw, PageSize);
-		m_cache.erase(it);
+		WriteWithoutCache(&cachePage->raw[0], page * PageSizeRaw, PageSize);
+		m_cache.Erase(page);
 		return true;
 	}
 	return false;
@@ -1453,20 +1436,20 @@ void FolderMemoryCard::RemoveUnchangedDataFromCache(const MemoryCardFileEntry* c
 		for (int i = 0; i < 2; ++i)
 		{
 			const u32 page = (cluster + alloc_offset) * 2 + i;
-			auto newIt = m_cache.find(page);
-			if (newIt == m_cache.end())
+			const MemoryCardPage* newPage = m_cache.Find(page);
+			if (newPage == nullptr)
 			{
 				continue;
 			}
-			auto oldIt = m_oldDataCache.find(page);
-			if (oldIt == m_oldDataCache.end())
+			const MemoryCardPage* oldPage = m_oldDataCache.Find(page);
+			if (oldPage == nullptr)
 			{
 				continue;
 			}
 
-			if (memcmp(&oldIt->second.raw[0], &newIt->second.raw[0], PageSize) == 0)
+			if (memcmp(&oldPage->raw[0], &newPage->raw[0], PageSize) == 0)
 			{
-				m_cache.erase(newIt);
+				m_cache.Erase(page);
 			}
 		}
 
@@ -1531,15 +1514,14 @@ bool FolderMemoryCard::WriteToFile(const u8* src, u32 adr, u32 dataLength)
 	}
 
 	// figure out which file to write to
-	auto it = m_fileMetadataQuickAccess.find(fatCluster);
-	if (it != m_fileMetadataQuickAccess.end())
+	if (MemoryCardFileMetadataReference* fileRef = m_fileMetadataQuickAccess.Find(fatCluster))
 	{
-		const MemoryCardFileEntry* const entry = it->second.entry;
-		const u32 clusterNumber = it->second.consecutiveCluster;
+		const MemoryCardFileEntry* const entry = fileRef->entry;
+		const u32 clusterNumber = fileRef->consecutiveCluster;
 
 		if (m_performFileWrites)
 		{
-			std::FILE* file = m_lastAccessedFile.ReOpen(m_folderName, &it->second, true);
+			std::FILE* file = m_lastAccessedFile.ReOpen(m_folderName, fileRef, true);
 			if (file)
 			{
 				const u32 clusterOffset = (page % 2) * PageSize + offset;
@@ -1788,6 +1770,18 @@ std::vector<FolderMemoryCard::EnumeratedFileEntry> FolderMemoryCard::GetOrderedF
 	FileSystem::FindFiles(dirPath.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_FOLDERS | FILESYSTEM_FIND_RELATIVE_PATHS | FILESYSTEM_FIND_HIDDEN_FILES, &results);
 	if (!results.empty())
 	{
+		// the index file shows up in the listing, so checking it against the cache needs no extra file access
+		const IndexFile* index = nullptr;
+		for (const FILESYSTEM_FIND_DATA& fd : results)
+		{
+			if (fd.FileName == "_pcsx2_index" && !(fd.Attributes & FILESYSTEM_FILE_ATTRIBUTE_DIRECTORY))
+			{
+				const FILESYSTEM_STAT_DATA indexStat{fd.CreationTime, fd.ModificationTime, fd.Size, fd.Attributes};
+				index = GetIndexFile(dirPath, &indexStat);
+				break;
+			}
+		}
+
 		// We must be able to support legacy folder memcards without the index file, so for those
 		// track an order variable and make it negative - this way new files get their order preserved
 		// and old files are listed first.
@@ -1804,34 +1798,26 @@ std::vector<FolderMemoryCard::EnumeratedFileEntry> FolderMemoryCard::GetOrderedF
 			if (StringUtil::StartsWith(fd.FileName, "_pcsx2_"))
 				continue;
 
-			std::string filePath(Path::Combine(dirPath, fd.FileName));
 			if (!(fd.Attributes & FILESYSTEM_FILE_ATTRIBUTE_DIRECTORY))
 			{
-				std::optional<ryml::Tree> yaml = loadYamlFile(Path::Combine(dirPath, "_pcsx2_index").c_str());
-
-				EnumeratedFileEntry entry{fd.FileName, fd.CreationTime, fd.ModificationTime, true};
+				EnumeratedFileEntry entry{fd.FileName, fd.CreationTime, fd.ModificationTime, fd.Size, true};
 				int64_t newOrder = orderForLegacyFiles--;
-				if (yaml.has_value() && !yaml.value().empty())
+				if (index)
 				{
-					ryml::NodeRef index = yaml.value().rootref();
-					for (const auto& n : index.children())
-					{
-						auto key = std::string(n.key().str, n.key().len);
-					}
-					if (index.has_child(c4::to_csubstr(fd.FileName)))
+					if (auto it = index->m_entries.find(fd.FileName); it != index->m_entries.end())
 					{
-						const auto& node = index[c4::to_csubstr(fd.FileName)];
-						if (node.has_child("timeCreated"))
+						const IndexFileEntry& node = it->second;
+						if (node.m_flags & IndexFileEntry::HasTimeCreated)
 						{
-							node["timeCreated"] >> entry.m_timeCreated;
+							entry.m_timeCreated = node.m_timeCreated;
 						}
-						if (node.has_child("timeModified"))
+						if (node.m_flags & IndexFileEntry::HasTimeModified)
 						{
-							node["timeModified"] >> entry.m_timeModified;
+							entry.m_timeModified = node.m_timeModified;
 						}
-						if (node.has_child("order"))
+						if (node.m_flags & IndexFileEntry::HasOrder)
 						{
-							node["order"] >> newOrder;
+							newOrder = node.m_order;
 						}
 					}
 				}
@@ -1844,48 +1830,23 @@ std::vector<FolderMemoryCard::EnumeratedFileEntry> FolderMemoryCard::GetOrderedF
 			{
 				std::string subDirPath(Path::Combine(dirPath, fd.FileName));
 
-				std::string subDirIndexPath(Path::Combine(subDirPath, "_pcsx2_index"));
-				std::optional<ryml::Tree> yaml = loadYamlFile(subDirIndexPath.c_str());
+				FILESYSTEM_STAT_DATA subDirIndexStat;
+				const bool hasSubDirIndex = FileSystem::StatFile(Path::Combine(subDirPath, "_pcsx2_index").c_str(), &subDirIndexStat);
+				const IndexFile* indexForDirectory = GetIndexFile(subDirPath, hasSubDirIndex ? &subDirIndexStat : nullptr);
 
-				EnumeratedFileEntry entry{fd.FileName, fd.CreationTime, fd.ModificationTime, false};
-				if (yaml.has_value() && !yaml.value().empty())
+				EnumeratedFileEntry entry{fd.FileName, fd.CreationTime, fd.ModificationTime, 0, false};
+				if (indexForDirectory)
 				{
-					ryml::NodeRef indexForDirectory = yaml.value().rootref();
-
-					// Detect broken index files, every index file should have atleast ONE child ('[$%]ROOT')
-					if (!indexForDirectory.has_children())
-					{
-						AttemptToRecreateIndexFile(subDirPath);
-						yaml = loadYamlFile(subDirIndexPath.c_str());
-						indexForDirectory = yaml.value().rootref();
-					}
-
-					const ryml::NodeRef entryNode;
-					if (indexForDirectory.has_child("%ROOT"))
-					{
-						// NOTE - working around a rapidyaml issue that needs to get resolved upstream
-						// '%' is a directive in YAML and it's not being quoted, this makes the memcards backwards compatible
-						// switched from '%' to '$'
-						const auto& node = indexForDirectory["%ROOT"];
-						if (node.has_child("timeCreated"))
-						{
-							node["timeCreated"] >> entry.m_timeCreated;
-						}
-						if (node.has_child("timeModified"))
-						{
-							node["timeModified"] >> entry.m_timeModified;
-						}
-					}
-					else if (indexForDirectory.has_child("$ROOT"))
+					if (auto it = indexForDirectory->m_entries.find("$ROOT"); it != indexForDirectory->m_entries.end())
 					{
-						const auto& node = indexForDirectory["$ROOT"];
-						if (node.has_child("timeCreated"))
+						const IndexFileEntry& node = it->second;
+						if (node.m_flags & IndexFileEntry::HasTimeCreated)
 						{
-							node["timeCreated"] >> entry.m_timeCreated;
+							entry.m_timeCreated = node.m_timeCreated;
 						}
-						if (node.has_child("timeModified"))
+						if (node.m_flags & IndexFileEntry::HasTimeModified)
 						{
-							node["timeModified"] >> entry.m_timeModified;
+							entry.m_timeModified = node.m_timeModified;
 						}
 					}
 				}
@@ -1907,6 +1868,229 @@ std::vector<FolderMemoryCard::EnumeratedFileEntry> FolderMemoryCard::GetOrderedF
 	return result;
 }
 
+const FolderMemoryCard::IndexFile* FolderMemoryCard::GetIndexFile(const std::string& dirPath, const FILESYSTEM_STAT_DATA* indexStat) const
+{
+	if (!indexStat)
+	{
+		return nullptr;
+	}
+
+	const std::string key(dirPath.substr(std::min(m_folderName.length() + 1, dirPath.length())));
+	auto it = m_indexCache.find(key);
+	if (it != m_indexCache.end() && it->second.m_indexModified == indexStat->ModificationTime && it->second.m_indexSize == indexStat->Size)
+	{
+		it->second.m_used = true;
+		return &it->second;
+	}
+
+	const std::string indexFileName(Path::Combine(dirPath, "_pcsx2_index"));
+	std::optional<ryml::Tree> yaml = loadYamlFile(indexFileName.c_str());
+	FILESYSTEM_STAT_DATA stat = *indexStat;
+
+	// Detect broken index files, every index file should have atleast ONE child ('[$%]ROOT')
+	if (yaml.has_value() && !yaml.value().empty() && !yaml.value().rootref().has_children())
+	{
+		AttemptToRecreateIndexFile(dirPath);
+		yaml = loadYamlFile(indexFileName.c_str());
+		if (!FileSystem::StatFile(indexFileName.c_str(), &stat))
+		{
+			stat = {};
+		}
+	}
+
+	IndexFile& index = m_indexCache[key];
+	index.m_indexModified = stat.ModificationTime;
+	index.m_indexSize = stat.Size;
+	index.m_entries.clear();
+	index.m_used = true;
+	m_indexCacheDirty = true;
+
+	if (yaml.has_value() && !yaml.value().empty())
+	{
+		for (const auto& n : yaml.value().rootref().children())
+		{
+			if (!n.has_key() || !n.is_map())
+			{
+				continue;
+			}
+
+			IndexFileEntry entry = {};
+			if (n.has_child("timeCreated"))
+			{
+				n["timeCreated"] >> entry.m_timeCreated;
+				entry.m_flags |= IndexFileEntry::HasTimeCreated;
+			}
+			if (n.has_child("timeModified"))
+			{
+				n["timeModified"] >> entry.m_timeModified;
+				entry.m_flags |= IndexFileEntry::HasTimeModified;
+			}
+			if (n.has_child("order"))
+			{
+				n["order"] >> entry.m_order;
+				entry.m_flags |= IndexFileEntry::HasOrder;
+			}
+
+			index.m_entries.insert_or_assign(std::string(n.key().str, n.key().len), entry);
+		}
+
+		// NOTE - working around a rapidyaml issue that needs to get resolved upstream
+		// '%' is a directive in YAML and it's not being quoted, this makes the memcards backwards compatible
+		// switched from '%' to '$'
+		if (auto legacyRoot = index.m_entries.find("%ROOT"); legacyRoot != index.m_entries.end())
+		{
+			index.m_entries.insert_or_assign("$ROOT", legacyRoot->second);
+			index.m_entries.erase("%ROOT");
+		}
+	}
+
+	return &index;
+}
+
+static constexpr u32 INDEX_CACHE_MAGIC = 0x43585049; // IPXC
+static constexpr u32 INDEX_CACHE_VERSION = 1;
+
+void FolderMemoryCard::LoadIndexCache()
+{
+	m_indexCache.clear();
+	m_indexCacheDirty = false;
+
+	const std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(Path::Combine(m_folderName, "_pcsx2_index_cache").c_str());
+	if (!data.has_value())
+	{
+		return;
+	}
+
+	size_t pos = 0;
+	const auto read = [&data, &pos](void* dest, size_t size) {
+		if (pos + size > data->size())
+			return false;
+
+		memcpy(dest, data->data() + pos, size);
+		pos += size;
+		return true;
+	};
+	const auto readString = [&read](std::string* str) {
+		u16 length;
+		if (!read(&length, sizeof(length)))
+			return false;
+
+		str->resize(length);
+		return read(str->data(), length);
+	};
+
+	u32 magic, version, dirCount;
+	if (!read(&magic, sizeof(magic)) || !read(&version, sizeof(version)) || !read(&dirCount, sizeof(dirCount)) ||
+		magic != INDEX_CACHE_MAGIC || version != INDEX_CACHE_VERSION)
+	{
+		return;
+	}
+
+	for (u32 i = 0; i < dirCount; ++i)
+	{
+		std::string dirKey;
+		IndexFile index;
+		s64 indexModified;
+		u32 entryCount;
+		if (!readString(&dirKey) || !read(&indexModified, sizeof(indexModified)) || !read(&index.m_indexSize, sizeof(index.m_indexSize)) ||
+			!read(&entryCount, sizeof(entryCount)))
+		{
+			m_indexCache.clear();
+			return;
+		}
+
+		index.m_indexModified = static_cast<time_t>(indexModified);
+		index.m_used = false;
+
+		for (u32 j = 0; j < entryCount; ++j)
+		{
+			std::string name;
+			IndexFileEntry entry;
+			s64 timeCreated, timeModified;
+			if (!readString(&name) || !read(&timeCreated, sizeof(timeCreated)) || !read(&timeModified, sizeof(timeModified)) ||
+				!read(&entry.m_order, sizeof(entry.m_order)) || !read(&entry.m_flags, sizeof(entry.m_flags)))
+			{
+				m_indexCache.clear();
+				return;
+			}
+
+			entry.m_timeCreated = static_cast<time_t>(timeCreated);
+			entry.m_timeModified = static_cast<time_t>(timeModified);
+			index.m_entries.emplace(std::move(name), entry);
+		}
+
+		m_indexCache.emplace(std::move(dirKey), std::move(index));
+	}
+}
+
+void FolderMemoryCard::SaveIndexCache()
+{
+	// drop directories which no longer exist, unless they were just filtered out
+	if (!m_filteringEnabled)
+	{
+		for (auto it = m_indexCache.begin(); it != m_indexCache.end();)
+		{
+			if (!it->second.m_used)
+			{
+				it = m_indexCache.erase(it);
+				m_indexCacheDirty = true;
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	if (!m_indexCacheDirty || !m_performFileWrites)
+	{
+		return;
+	}
+
+	std::vector<u8> data;
+	const auto write = [&data](const void* src, size_t size) {
+		data.insert(data.end(), static_cast<const u8*>(src), static_cast<const u8*>(src) + size);
+	};
+	const auto writeString = [&write](const std::string& str) {
+		const u16 length = static_cast<u16>(std::min<size_t>(str.length(), std::numeric_limits<u16>::max()));
+		write(&length, sizeof(length));
+		write(str.data(), length);
+	};
+
+	const u32 dirCount = static_cast<u32>(m_indexCache.size());
+	write(&INDEX_CACHE_MAGIC, sizeof(INDEX_CACHE_MAGIC));
+	write(&INDEX_CACHE_VERSION, sizeof(INDEX_CACHE_VERSION));
+	write(&dirCount, sizeof(dirCount));
+
+	for (const auto& [dirKey, index] : m_indexCache)
+	{
+		const s64 indexModified = index.m_indexModified;
+		const u32 entryCount = static_cast<u32>(index.m_entries.size());
+		writeString(dirKey);
+		write(&indexModified, sizeof(indexModified));
+		write(&index.m_indexSize, sizeof(index.m_indexSize));
+		write(&entryCount, sizeof(entryCount));
+
+		for (const auto& [name, entry] : index.m_entries)
+		{
+			const s64 timeCreated = entry.m_timeCreated;
+			const s64 timeModified = entry.m_timeModified;
+			writeString(name);
+			write(&timeCreated, sizeof(timeCreated));
+			write(&timeModified, sizeof(timeModified));
+			write(&entry.m_order, sizeof(entry.m_order));
+			write(&entry.m_flags, sizeof(entry.m_flags));
+		}
+	}
+
+	if (!FileSystem::WriteBinaryFile(Path::Combine(m_folderName, "_pcsx2_index_cache").c_str(), data.data(), data.size()))
+	{
+		Console.Warning("(FolderMcd) Failed to write index cache for slot %u.", m_slot);
+	}
+
+	m_indexCacheDirty = false;
+}
+
 void FolderMemoryCard::DeleteFromIndex(const std::string& filePath, const std::string_view& entry) const
 {
 	const std::string indexName(Path::Combine(filePath, "_pcsx2_index"));
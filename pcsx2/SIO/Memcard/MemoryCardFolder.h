@@ -15,12 +15,15 @@
 
 #pragma once
 
+#include <deque>
 #include <map>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "Config.h"
+#include "common/FileSystem.h"
 
 #include "fmt/core.h"
 
@@ -153,6 +156,74 @@ struct MemoryCardPage
 };
 #pragma pack(pop)
 
+// --------------------------------------------------------------------------------------
+//  MemoryCardFlatMap
+// --------------------------------------------------------------------------------------
+// Maps page/cluster numbers to values through a flat index array, used in place of std::map
+// for the per-page and per-cluster caches. Values live in a deque and are recycled on erase,
+// so pointers to them stay valid like they would in a std::map.
+template <typename T>
+class MemoryCardFlatMap
+{
+	static constexpr u32 NoValue = 0xFFFFFFFFu;
+
+	std::vector<u32> m_index;
+	std::deque<T> m_values;
+	std::vector<u32> m_freeValues;
+
+public:
+	bool Empty() const { return m_values.size() == m_freeValues.size(); }
+
+	T* Find(u32 key)
+	{
+		if (key >= m_index.size() || m_index[key] == NoValue)
+			return nullptr;
+
+		return &m_values[m_index[key]];
+	}
+
+	T& operator[](u32 key)
+	{
+		if (key >= m_index.size())
+			m_index.resize(key + 1, NoValue);
+
+		u32& index = m_index[key];
+		if (index == NoValue)
+		{
+			if (!m_freeValues.empty())
+			{
+				index = m_freeValues.back();
+				m_freeValues.pop_back();
+				m_values[index] = T();
+			}
+			else
+			{
+				index = static_cast<u32>(m_values.size());
+				m_values.emplace_back();
+			}
+		}
+
+		return m_values[index];
+	}
+
+	bool Erase(u32 key)
+	{
+		if (key >= m_index.size() || m_index[key] == NoValue)
+			return false;
+
+		m_freeValues.push_back(m_index[key]);
+		m_index[key] = NoValue;
+		return true;
+	}
+
+	void Clear()
+	{
+		m_index.clear();
+		m_values.clear();
+		m_freeValues.clear();
+	}
+};
+
 struct MemoryCardFileEntryTreeNode
 {
 	MemoryCardFileEntry entry;
@@ -285,16 +356,16 @@ protected:
 	} m_backupBlock2;
 
 	// stores directory and file metadata
-	std::map<u32, MemoryCardFileEntryCluster> m_fileEntryDict;
+	MemoryCardFlatMap<MemoryCardFileEntryCluster> m_fileEntryDict;
 	// quick-access map of related file entry metadata for each memory card FAT cluster that contains file data
-	std::map<u32, MemoryCardFileMetadataReference> m_fileMetadataQuickAccess;
+	MemoryCardFlatMap<MemoryCardFileMetadataReference> m_fileMetadataQuickAccess;
 
 	// holds a copy of modified pages of the memory card before they're flushed to the file system
-	std::map<u32, MemoryCardPage> m_cache;
+	MemoryCardFlatMap<MemoryCardPage> m_cache;
 	// contains the state of how the data looked before the first write to it
 	// used to reduce the amount of disk I/O by not re-writing unchanged data that just happened to be
 	// touched in memory due to how actual physical memory cards have to erase and rewrite in blocks
-	std::map<u32, MemoryCardPage> m_oldDataCache;
+	MemoryCardFlatMap<MemoryCardPage> m_oldDataCache;
 	// if > 0, the amount of frames until data is flushed to the file system
 	// reset to FramesAfterWriteUntilFlush on each write
 	int m_framesUntilFlush;
@@ -371,9 +442,40 @@ protected:
 		std::string m_fileName;
 		time_t m_timeCreated;
 		time_t m_timeModified;
+		s64 m_size;
 		bool m_isFile;
 	};
 
+	// the parsed contents of a directory's _pcsx2_index, the directory's own timestamps are stored as "$ROOT"
+	struct IndexFileEntry
+	{
+		enum : u8
+		{
+			HasTimeCreated = 1 << 0,
+			HasTimeModified = 1 << 1,
+			HasOrder = 1 << 2,
+		};
+
+		time_t m_timeCreated;
+		time_t m_timeModified;
+		int64_t m_order;
+		u8 m_flags;
+	};
+
+	struct IndexFile
+	{
+		// modification time and size of the _pcsx2_index this was parsed from, used to detect changes
+		time_t m_indexModified;
+		s64 m_indexSize;
+		std::unordered_map<std::string, IndexFileEntry> m_entries;
+		bool m_used;
+	};
+
+	// parsed index files of all directories, keyed by the directory path relative to the card folder
+	// persisted in _pcsx2_index_cache so reopening the card doesn't have to parse every index again
+	mutable std::unordered_map<std::string, IndexFile> m_indexCache;
+	mutable bool m_indexCacheDirty = false;
+
 	// initializes memory card data, as if it was fresh from the factory
 	void InitializeInternalData();
 
@@ -457,7 +559,8 @@ protected:
 	// - dirPath: the full path to the directory containing the file in the host file system
 	// - fileName: the name of the file, without path
 	// - parent: pointer to the parent dir's quick-access reference element
-	bool AddFile(MemoryCardFileEntry* const dirEntry, const std::string& dirPath, const EnumeratedFileEntry& fileEntry, MemoryCardFileMetadataReference* parent = nullptr);
+	// - hasMetadata: whether dirPath has a _pcsx2_meta folder that may contain metadata for this file
+	bool AddFile(MemoryCardFileEntry* const dirEntry, const std::string& dirPath, const EnumeratedFileEntry& fileEntry, MemoryCardFileMetadataReference* parent = nullptr, const bool hasMetadata = true);
 
 	// calculates the amount of clusters a directory would use up if put into a memory card
 	u32 CalculateRequiredClustersOfDirectory(const std::string& dirPath) const;
@@ -537,6 +640,13 @@ protected:
 	std::vector<EnumeratedFileEntry> GetOrderedFiles(const std::string& dirPath) const;
 
 	void DeleteFromIndex(const std::string& filePath, const std::string_view& entry) const;
+
+	// returns the parsed index file of dirPath, only reading the file if it changed since it was cached
+	// - indexStat: modification time and size of the index file, or nullptr if there is none
+	const IndexFile* GetIndexFile(const std::string& dirPath, const FILESYSTEM_STAT_DATA* indexStat) const;
+
+	void LoadIndexCache();
+	void SaveIndexCache();
 };
 
 // --------------------------------------------------------------------------------------
@@ -76,6 +76,8 @@ static void PreLoadPrep()
 static void PostLoadPrep()
 {
 	resetCache();
+	cpuRebuildEventQueue();
+	psxRebuildEventQueue();
 //	WriteCP0Status(cpuRegs.CP0.n.Status.val);
 	for (int i = 0; i < 48; i++)
 	{
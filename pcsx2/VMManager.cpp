@@ -18,6 +18,7 @@
 #include "Achievements.h"
 #include "CDVD/CDVD.h"
 #include "CDVD/IsoReader.h"
+#include "Cache.h"
 #include "Counters.h"
 #include "DEV9/DEV9.h"
 #include "DebugTools/MIPSAnalyst.h"
@@ -52,6 +53,7 @@
 #include "SPU2/spu2.h"
 #include "USB/USB.h"
 #include "VMManager.h"
+#include "VUmicro.h"
 #include "ps2/BiosTools.h"
 
 #include "common/Console.h"
@@ -906,6 +908,8 @@ void VMManager::UpdateDiscDetails(bool booting)
 	Achievements::GameChanged(s_disc_crc, s_current_crc);
 	if (MTGS::IsOpen())
 		MTGS::SendGameCRC(s_disc_crc);
+	if (!GSDumpReplayer::IsReplayingDump())
+		mVUopenProgramCache(s_disc_serial, s_disc_crc);
 	ReloadPINE();
 	UpdateDiscordPresence(Achievements::GetRichPresenceString());
 
@@ -1337,6 +1341,7 @@ void VMManager::Shutdown(bool save_resume_state)
 	}
 
 	SaveSessionTime(s_disc_serial);
+	mVUcloseProgramCache();
 	s_elf_override = {};
 	ClearELFInfo();
 	CDVDsys_ClearFiles();
@@ -2039,8 +2044,14 @@ void VMManager::CheckForCPUConfigChanges(const Pcsx2Config& old_config)
 	SysClearExecutionCache();
 	memBindConditionalHandlers();
 
-	if (EmuConfig.Cpu.Recompiler.EnableFastmem != old_config.Cpu.Recompiler.EnableFastmem)
+	if (EmuConfig.Cpu.Recompiler.EnableFastmem != old_config.Cpu.Recompiler.EnableFastmem ||
+		EmuConfig.Cpu.Recompiler.EnableEECache != old_config.Cpu.Recompiler.EnableEECache)
+	{
 		vtlb_ResetFastmem();
+	}
+
+	if (EmuConfig.Cpu.Recompiler.EnableEECache != old_config.Cpu.Recompiler.EnableEECache)
+		updateCacheablePages();
 
 	// did we toggle recompilers?
 	if (EmuConfig.Cpu.CpusChanged(old_config.Cpu))
@@ -179,6 +179,11 @@ extern recMicroVU1 CpuMicroVU1;
 extern BaseVUmicroCPU* CpuVU0;
 extern BaseVUmicroCPU* CpuVU1;
 
+// Persistent microVU program cache, keyed by game serial and CRC.
+// Programs recompiled during a session are recompiled up front the next time the game runs.
+extern void mVUopenProgramCache(const std::string& serial, u32 crc);
+extern void mVUcloseProgramCache();
+
 
 // VU0
 extern void vu0ResetRegs();
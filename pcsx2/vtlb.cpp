@@ -43,8 +43,6 @@
 #include "fmt/core.h"
 
 #include <map>
-#include <unordered_set>
-#include <unordered_map>
 
 #define FASTMEM_LOG(...)
 //#define FASTMEM_LOG(...) Console.WriteLn(__VA_ARGS__)
@@ -87,15 +85,147 @@ struct LoadstoreBackpatchInfo
 	bool is_fpr;
 };
 
+// Open addressed hash table with linear probing, for the fastmem bookkeeping which is looked
+// up on every recompiled loadstore and fault. Deletion shifts entries back instead of leaving
+// tombstones, so lookups never get slower as the table churns.
+template <typename K, typename V, K EmptyKey>
+class FastmemHashTable
+{
+public:
+	explicit FastmemHashTable(size_t initial_capacity)
+		: m_initial_capacity(initial_capacity)
+	{
+	}
+
+	V* Find(K key)
+	{
+		if (m_count == 0)
+			return nullptr;
+
+		const size_t mask = m_entries.size() - 1;
+		for (size_t i = Hash(key) & mask;; i = (i + 1) & mask)
+		{
+			Entry& entry = m_entries[i];
+			if (entry.key == key)
+				return &entry.value;
+			if (entry.key == EmptyKey)
+				return nullptr;
+		}
+	}
+
+	// Inserts the key, replacing any existing value.
+	void Insert(K key, const V& value)
+	{
+		pxAssert(key != EmptyKey);
+		if ((m_count + 1) * 2 > m_entries.size())
+			Grow();
+
+		const size_t mask = m_entries.size() - 1;
+		size_t i = Hash(key) & mask;
+		while (m_entries[i].key != EmptyKey && m_entries[i].key != key)
+			i = (i + 1) & mask;
+
+		if (m_entries[i].key == EmptyKey)
+			m_count++;
+
+		m_entries[i].key = key;
+		m_entries[i].value = value;
+	}
+
+	void Erase(K key)
+	{
+		if (m_count == 0)
+			return;
+
+		const size_t mask = m_entries.size() - 1;
+		size_t hole = Hash(key) & mask;
+		while (m_entries[hole].key != key)
+		{
+			if (m_entries[hole].key == EmptyKey)
+				return;
+			hole = (hole + 1) & mask;
+		}
+
+		m_count--;
+
+		// pull back any following entries which would no longer be reachable through the hole
+		for (size_t i = (hole + 1) & mask; m_entries[i].key != EmptyKey; i = (i + 1) & mask)
+		{
+			const size_t home = Hash(m_entries[i].key) & mask;
+			if (((i - home) & mask) >= ((i - hole) & mask))
+			{
+				m_entries[hole] = m_entries[i];
+				hole = i;
+			}
+		}
+
+		m_entries[hole].key = EmptyKey;
+	}
+
+	void Clear()
+	{
+		if (m_count == 0)
+			return;
+
+		for (Entry& entry : m_entries)
+			entry.key = EmptyKey;
+		m_count = 0;
+	}
+
+	void Release()
+	{
+		decltype(m_entries)().swap(m_entries);
+		m_count = 0;
+	}
+
+private:
+	struct Entry
+	{
+		K key;
+		V value;
+	};
+
+	static __fi size_t Hash(K key)
+	{
+		return static_cast<size_t>((static_cast<u64>(key) * 0x9E3779B97F4A7C15ULL) >> 32);
+	}
+
+	void Grow()
+	{
+		std::vector<Entry> old_entries(std::max(m_entries.size() * 2, m_initial_capacity), Entry{EmptyKey, V()});
+		old_entries.swap(m_entries);
+
+		const size_t mask = m_entries.size() - 1;
+		for (const Entry& entry : old_entries)
+		{
+			if (entry.key == EmptyKey)
+				continue;
+
+			size_t i = Hash(entry.key) & mask;
+			while (m_entries[i].key != EmptyKey)
+				i = (i + 1) & mask;
+			m_entries[i] = entry;
+		}
+	}
+
+	std::vector<Entry> m_entries;
+	size_t m_count = 0;
+	size_t m_initial_capacity;
+};
+
 static constexpr size_t FASTMEM_AREA_SIZE = 0x100000000ULL;
 static constexpr u32 FASTMEM_PAGE_COUNT = FASTMEM_AREA_SIZE / VTLB_PAGE_SIZE;
+static constexpr u32 FASTMEM_MAINMEM_PAGE_COUNT = HostMemoryMap::MainSize / VTLB_PAGE_SIZE;
 static constexpr u32 NO_FASTMEM_MAPPING = 0xFFFFFFFFu;
 
+// The reverse mapping is an intrusive list per mainmem page: s_fastmem_physical_mapping holds
+// the first vpage aliasing that page, and s_fastmem_physical_next links the remaining aliases.
 static std::unique_ptr<SharedMemoryMappingArea> s_fastmem_area;
-static std::vector<u32> s_fastmem_virtual_mapping; // maps vaddr -> mainmem offset
-static std::unordered_multimap<u32, u32> s_fastmem_physical_mapping; // maps mainmem offset -> vaddr
-static std::unordered_map<uptr, LoadstoreBackpatchInfo> s_fastmem_backpatch_info;
-static std::unordered_set<u32> s_fastmem_faulting_pcs;
+static std::vector<u32> s_fastmem_virtual_mapping; // maps vpage -> mainmem offset
+static std::vector<u32> s_fastmem_physical_mapping; // maps mainmem page -> first vpage
+static std::vector<u32> s_fastmem_physical_next; // maps vpage -> next vpage with the same mainmem page
+static FastmemHashTable<uptr, LoadstoreBackpatchInfo, 0> s_fastmem_backpatch_info(0x10000);
+static FastmemHashTable<u32, bool, NO_FASTMEM_MAPPING> s_fastmem_faulting_pcs(0x400);
 
 vtlb_private::VTLBPhysical vtlb_private::VTLBPhysical::fromPointer(sptr ptr)
 {
@@ -125,38 +255,8 @@ vtlb_private::VTLBVirtual::VTLBVirtual(VTLBPhysical phys, u32 paddr, u32 vaddr)
 
 __inline int CheckCache(u32 addr)
 {
-	u32 mask;
-
-	if (((cpuRegs.CP0.n.Config >> 16) & 0x1) == 0)
-	{
-		//DevCon.Warning("Data Cache Disabled! %x", cpuRegs.CP0.n.Config);
-		return false; //
-	}
-
-	for (int i = 1; i < 48; i++)
-	{
-		if (((tlb[i].EntryLo1 & 0x38) >> 3) == 0x3)
-		{
-			mask = tlb[i].PageMask;
-
-			if ((addr >= tlb[i].PFN1) && (addr <= tlb[i].PFN1 + mask))
-			{
-				//DevCon.Warning("Yay! Cache check cache addr=%x, mask=%x, addr+mask=%x, VPN2=%x PFN0=%x", addr, mask, (addr & mask), tlb[i].VPN2, tlb[i].PFN0);
-				return true;
-			}
-		}
-		if (((tlb[i].EntryLo0 & 0x38) >> 3) == 0x3)
-		{
-			mask = tlb[i].PageMask;
-
-			if ((addr >= tlb[i].PFN0) && (addr <= tlb[i].PFN0 + mask))
-			{
-				//DevCon.Warning("Yay! Cache check cache addr=%x, mask=%x, addr+mask=%x, VPN2=%x PFN0=%x", addr, mask, (addr & mask), tlb[i].VPN2, tlb[i].PFN0);
-				return true;
-			}
-		}
-	}
-	return false;
+	const u32 page = addr >> 12;
+	return (cacheablePages[page / 32] >> (page % 32)) & 1;
 }
 // --------------------------------------------------------------------------------------
 // Interpreter Implementations of VTLB Memory Operations.
@@ -895,6 +995,28 @@ static bool vtlb_GetMainMemoryOffset(u32 paddr, u32* mainmem_offset, u32* mainme
 	return vtlb_GetMainMemoryOffsetFromPtr(vm.raw(), mainmem_offset, mainmem_size, prot);
 }
 
+static void vtlb_AddFastmemAlias(u32 page, u32 mainmem_offset)
+{
+	u32& head = s_fastmem_physical_mapping[mainmem_offset / VTLB_PAGE_SIZE];
+	s_fastmem_physical_next[page] = head;
+	head = page;
+}
+
+static void vtlb_RemoveFastmemAlias(u32 page, u32 mainmem_offset)
+{
+	u32* link = &s_fastmem_physical_mapping[mainmem_offset / VTLB_PAGE_SIZE];
+	while (*link != NO_FASTMEM_MAPPING)
+	{
+		if (*link == page)
+		{
+			*link = s_fastmem_physical_next[page];
+			return;
+		}
+
+		link = &s_fastmem_physical_next[*link];
+	}
+}
+
 static void vtlb_CreateFastmemMapping(u32 vaddr, u32 mainmem_offset, const PageProtectionMode& mode)
 {
 	FASTMEM_LOG("Create fastmem mapping @ vaddr %08X mainmem %08X", vaddr, mainmem_offset);
@@ -912,18 +1034,12 @@ static void vtlb_CreateFastmemMapping(u32 vaddr, u32 mainmem_offset, const PageP
 		// current mapping needs to be removed
 		const bool was_coalesced = vtlb_IsHostCoalesced(page);
 
+		// remove reverse mapping
+		vtlb_RemoveFastmemAlias(page, s_fastmem_virtual_mapping[page]);
+
 		s_fastmem_virtual_mapping[page] = NO_FASTMEM_MAPPING;
 		if (was_coalesced && !s_fastmem_area->Unmap(s_fastmem_area->PagePointer(vtlb_HostPage(page)), __pagesize))
 			Console.Error("Failed to unmap vaddr %08X", vaddr);
-
-		// remove reverse mapping
-		auto range = s_fastmem_physical_mapping.equal_range(mainmem_offset);
-		for (auto it = range.first; it != range.second;)
-		{
-			auto this_it = it++;
-			if (this_it->second == vaddr)
-				s_fastmem_physical_mapping.erase(this_it);
-		}
 	}
 
 	s_fastmem_virtual_mapping[page] = mainmem_offset;
@@ -941,7 +1057,7 @@ static void vtlb_CreateFastmemMapping(u32 vaddr, u32 mainmem_offset, const PageP
 		}
 	}
 
-	s_fastmem_physical_mapping.emplace(mainmem_offset, vaddr);
+	vtlb_AddFastmemAlias(page, mainmem_offset);
 }
 
 static void vtlb_RemoveFastmemMapping(u32 vaddr)
@@ -959,13 +1075,7 @@ static void vtlb_RemoveFastmemMapping(u32 vaddr)
 		Console.Error("Failed to unmap vaddr %08X", vtlb_HostAlignOffset(vaddr));
 
 	// remove from reverse map
-	auto range = s_fastmem_physical_mapping.equal_range(mainmem_offset);
-	for (auto it = range.first; it != range.second;)
-	{
-		auto this_it = it++;
-		if (this_it->second == vaddr)
-			s_fastmem_physical_mapping.erase(this_it);
-	}
+	vtlb_RemoveFastmemAlias(page, mainmem_offset);
 }
 
 static void vtlb_RemoveFastmemMappings(u32 vaddr, u32 size)
@@ -1000,7 +1110,7 @@ static void vtlb_RemoveFastmemMappings()
 			Console.Error("Failed to unmap vaddr %08X", page * __pagesize);
 	}
 
-	s_fastmem_physical_mapping.clear();
+	std::fill(s_fastmem_physical_mapping.begin(), s_fastmem_physical_mapping.end(), NO_FASTMEM_MAPPING);
 }
 
 bool vtlb_ResolveFastmemMapping(uptr* addr)
@@ -1058,33 +1168,30 @@ void vtlb_UpdateFastmemProtection(u32 paddr, u32 size, const PageProtectionMode&
 	for (u32 i = 0; i < num_pages; i++, current_mainmem += VTLB_PAGE_SIZE)
 	{
 		// update virtual mapping mapping
-		auto range = s_fastmem_physical_mapping.equal_range(current_mainmem);
-		for (auto it = range.first; it != range.second; ++it)
+		for (u32 vpage = s_fastmem_physical_mapping[current_mainmem / VTLB_PAGE_SIZE]; vpage != NO_FASTMEM_MAPPING;
+			 vpage = s_fastmem_physical_next[vpage])
 		{
-			FASTMEM_LOG("  valias %08X (size %u)", it->second, VTLB_PAGE_SIZE);
+			const u32 valias = vpage * VTLB_PAGE_SIZE;
+			FASTMEM_LOG("  valias %08X (size %u)", valias, VTLB_PAGE_SIZE);
 
-			if (vtlb_IsHostAligned(it->second))
-				HostSys::MemProtect(s_fastmem_area->OffsetPointer(it->second), __pagesize, prot);
+			if (vtlb_IsHostAligned(valias))
+				HostSys::MemProtect(s_fastmem_area->OffsetPointer(valias), __pagesize, prot);
 		}
 	}
 }
 
 void vtlb_ClearLoadStoreInfo()
 {
-	s_fastmem_backpatch_info.clear();
-	s_fastmem_faulting_pcs.clear();
+	s_fastmem_backpatch_info.Clear();
+	s_fastmem_faulting_pcs.Clear();
 }
 
 void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr)
 {
 	pxAssert(code_size < std::numeric_limits<u8>::max());
 
-	auto iter = s_fastmem_backpatch_info.find(code_address);
-	if (iter != s_fastmem_backpatch_info.end())
-		s_fastmem_backpatch_info.erase(iter);
-
 	LoadstoreBackpatchInfo info{guest_pc, gpr_bitmask, fpr_bitmask, static_cast<u8>(code_size), address_register, data_register, size_in_bits, is_signed, is_load, is_fpr};
-	s_fastmem_backpatch_info.emplace(code_address, info);
+	s_fastmem_backpatch_info.Insert(code_address, info);
 }
 
 bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address)
@@ -1094,11 +1201,11 @@ bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address)
 	if (fault_address < fastmem_start || fault_address > fastmem_end)
 		return false;
 
-	auto iter = s_fastmem_backpatch_info.find(code_address);
-	if (iter == s_fastmem_backpatch_info.end())
+	const LoadstoreBackpatchInfo* iter = s_fastmem_backpatch_info.Find(code_address);
+	if (!iter)
 		return false;
 
-	const LoadstoreBackpatchInfo& info = iter->second;
+	const LoadstoreBackpatchInfo info = *iter;
 	const u32 guest_addr = static_cast<u32>(fault_address - fastmem_start);
 	vtlb_DynBackpatchLoadStore(code_address, info.code_size, info.guest_pc, guest_addr,
 		info.gpr_bitmask, info.fpr_bitmask, info.address_register, info.data_register,
@@ -1108,14 +1215,14 @@ bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address)
 	Cpu->Clear(info.guest_pc, 1);
 
 	// and store the pc in the faulting list, so that we don't emit another fastmem loadstore
-	s_fastmem_faulting_pcs.insert(info.guest_pc);
-	s_fastmem_backpatch_info.erase(iter);
+	s_fastmem_faulting_pcs.Insert(info.guest_pc, true);
+	s_fastmem_backpatch_info.Erase(code_address);
 	return true;
 }
 
 bool vtlb_IsFaultingPC(u32 guest_pc)
 {
-	return (s_fastmem_faulting_pcs.find(guest_pc) != s_fastmem_faulting_pcs.end());
+	return (s_fastmem_faulting_pcs.Find(guest_pc) != nullptr);
 }
 
 //virtual mappings
@@ -1262,8 +1369,8 @@ void vtlb_Reset()
 void vtlb_Shutdown()
 {
 	vtlb_RemoveFastmemMappings();
-	s_fastmem_backpatch_info.clear();
-	s_fastmem_faulting_pcs.clear();
+	s_fastmem_backpatch_info.Clear();
+	s_fastmem_faulting_pcs.Clear();
 }
 
 void vtlb_ResetFastmem()
@@ -1271,8 +1378,8 @@ void vtlb_ResetFastmem()
 	DevCon.WriteLn("Resetting fastmem mappings...");
 
 	vtlb_RemoveFastmemMappings();
-	s_fastmem_backpatch_info.clear();
-	s_fastmem_faulting_pcs.clear();
+	s_fastmem_backpatch_info.Clear();
+	s_fastmem_faulting_pcs.Clear();
 
 	if (!CHECK_FASTMEM || !CHECK_EEREC || !vtlbdata.vmap)
 		return;
@@ -1333,6 +1440,8 @@ bool vtlb_Core_Alloc()
 		}
 
 		s_fastmem_virtual_mapping.resize(FASTMEM_PAGE_COUNT, NO_FASTMEM_MAPPING);
+		s_fastmem_physical_mapping.resize(FASTMEM_MAINMEM_PAGE_COUNT, NO_FASTMEM_MAPPING);
+		s_fastmem_physical_next.resize(FASTMEM_PAGE_COUNT, NO_FASTMEM_MAPPING);
 		vtlbdata.fastmem_base = (uptr)s_fastmem_area->BasePointer();
 		Console.WriteLn(Color_StrongGreen, "Fastmem area: %p - %p",
 			vtlbdata.fastmem_base, vtlbdata.fastmem_base + (FASTMEM_AREA_SIZE - 1));
@@ -1389,7 +1498,10 @@ void vtlb_Core_Free()
 
 	vtlbdata.fastmem_base = 0;
 	decltype(s_fastmem_physical_mapping)().swap(s_fastmem_physical_mapping);
+	decltype(s_fastmem_physical_next)().swap(s_fastmem_physical_next);
 	decltype(s_fastmem_virtual_mapping)().swap(s_fastmem_virtual_mapping);
+	s_fastmem_backpatch_info.Release();
+	s_fastmem_faulting_pcs.Release();
 	s_fastmem_area.reset();
 }
 
@@ -968,3 +968,111 @@ void _recFillRegister(EEINST& pinst, int type, int reg, int write)
 		pxAssume(false);
 	}
 }
+
+// The idea here is that as long as a loop doesn't write to a register it's already read
+// (excepting registers initialised with constants or memory loads) or use any instructions
+// which alter the machine state apart from registers, it will do the same thing on every
+// iteration.
+bool _recIsIdleLoop(u32 startpc, u32 endpc, u32 loads, u32 (*read_code)(u32 pc), bool iop,
+	bool (*is_volatile_addr)(u32 addr))
+{
+	u32 reads = 0;
+
+	// Constants the loop builds itself, used to work out the addresses it loads from. The
+	// values registers hold on entry can't be trusted, the block is reused with others later.
+	u32 known = 1;
+	u32 values[32] = {};
+
+	for (u32 i = startpc; i < endpc; i += 4)
+	{
+		if (i == endpc - 8)
+			continue;
+
+		const u32 code = read_code(i);
+		const u32 opcode = code >> 26;
+		const u32 funct = code & 0x3F;
+		const u32 rs = (code >> 21) & 0x1F;
+		const u32 rt = (code >> 16) & 0x1F;
+		const u32 rd = (code >> 11) & 0x1F;
+		const u32 imm = code & 0xFFFF;
+
+		// nop
+		if (code == 0)
+			continue;
+		// cache, sync
+		else if (!iop && (opcode == 057 || (opcode == 0 && funct == 017)))
+			continue;
+		// The 64-bit EE instructions below don't exist on the IOP
+		else if (iop && (opcode == 030 || opcode == 031 || opcode == 032 || opcode == 033 || opcode == 047 || opcode == 067 ||
+							(opcode == 0 && (funct & 074) == 054) || ((opcode & 074) == 020 && rs == 1)))
+			return false;
+		// imm arithmetic
+		else if ((opcode & 070) == 010 || (opcode & 076) == 030)
+		{
+			const bool rs_known = (known & 1 << rs) != 0;
+			known &= ~(1u << rt);
+			if (opcode == 017) // lui
+				values[rt] = imm << 16, known |= 1u << rt;
+			else if (opcode == 011 && rs_known) // addiu
+				values[rt] = values[rs] + static_cast<s16>(imm), known |= 1u << rt;
+			else if (opcode == 015 && rs_known) // ori
+				values[rt] = values[rs] | imm, known |= 1u << rt;
+			known |= 1u;
+
+			if (loads & 1 << rs)
+			{
+				loads |= 1 << rt;
+				continue;
+			}
+			else
+				reads |= 1 << rs;
+			if (reads & 1 << rt)
+				return false;
+		}
+		// common register arithmetic instructions
+		else if (opcode == 0 && (funct & 060) == 040 && (funct & 076) != 050)
+		{
+			known &= ~(1u << rd) | 1u;
+
+			if (loads & 1 << rs && loads & 1 << rt)
+			{
+				loads |= 1 << rd;
+				continue;
+			}
+			else
+				reads |= 1 << rs | 1 << rt;
+			if (reads & 1 << rd)
+				return false;
+		}
+		// loads
+		else if ((opcode & 070) == 040 || (opcode & 076) == 032 || opcode == 067)
+		{
+			// Give up on loads from addresses the loop doesn't build if anything is off limits.
+			if (is_volatile_addr && (!(known & 1 << rs) || is_volatile_addr(values[rs] + static_cast<s16>(imm))))
+				return false;
+			known &= ~(1u << rt) | 1u;
+
+			if (loads & 1 << rs)
+			{
+				loads |= 1 << rt;
+				continue;
+			}
+			else
+				reads |= 1 << rs;
+			if (reads & 1 << rt)
+				return false;
+		}
+		// mfc*, cfc*
+		else if ((opcode & 074) == 020 && rs < 4)
+		{
+			known &= ~(1u << rt) | 1u;
+			loads |= 1 << rt;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
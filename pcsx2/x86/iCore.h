@@ -239,6 +239,15 @@ extern u32 _recIsRegReadOrWritten(EEINST* pinst, int size, u8 xmmtype, u8 reg);
 
 extern void _recFillRegister(EEINST& pinst, int type, int reg, int write);
 
+// Idle loop detection, shared by the EE and IOP recompilers. Returns true if the loop from startpc
+// (branching back at endpc - 8) does the same thing on every iteration, until an event changes memory.
+// `loads` is the mask of GPRs which are treated as loaded from memory on entry, and read_code fetches
+// the instruction at an address. iop rejects the EE-only instructions. If is_volatile_addr is set,
+// loops which may load from an address it rejects (memory which changes without an event being
+// scheduled) aren't idle, and neither are loops loading from addresses not built in the loop itself.
+extern bool _recIsIdleLoop(u32 startpc, u32 endpc, u32 loads, u32 (*read_code)(u32 pc), bool iop = false,
+	bool (*is_volatile_addr)(u32 addr) = nullptr);
+
 // If unset, values which are not live will not be written back to memory.
 // Tends to break stuff at the moment.
 #define EE_WRITE_DEAD_VALUES 1
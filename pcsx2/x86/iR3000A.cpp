@@ -1106,6 +1106,23 @@ static __fi void recClearIOP(u32 Addr, u32 Size)
 		pc += PSXREC_CLEARM(pc);
 }
 
+// Emits the code invalidation for a direct store to iop ram. addr holds the masked, word
+// aligned address, and recClearIOP is only called when a block was compiled at that word.
+// Clobbers rax, r11 and (when clearing) any caller saved registers.
+void _psxClearRecRAM(const xRegister32& addr)
+{
+	xMOV(eax, addr);
+	xSHR(eax, 16);
+	xMOV(r11, ptrNative[xComplexAddress(r11, psxRecLUT, rax * wordsize)]);
+	xMOV(r11, ptrNative[xAddressReg(addr.GetId()) * (wordsize / 4) + r11]);
+	xMOV64(rax, (uptr)iopJITCompile);
+	xCMP(r11, rax);
+	xForwardJE8 no_block;
+	xMOV(arg2regd, 1);
+	xFastCall((void*)recClearIOP, addr);
+	no_block.SetTarget();
+}
+
 void psxSetBranchReg(u32 reg)
 {
 	psxbranch = 1;
@@ -1208,19 +1225,26 @@ static void iPsxBranchTest(u32 newpc, u32 cpuBranch)
 		xSUB(ptr32[&psxRegs.iopCycleEE], blockCycles * 8);
 		xJLE(iopExitRecompiledCode);
 
-		// check if an event is pending
+		// check if an event is pending, going straight to the next block if not
 		xSUB(eax, ptr32[&psxRegs.iopNextEventCycle]);
-		xForwardJS<u8> nointerruptpending;
-
-		xFastCall((void*)iopEventTest);
 
 		if (newpc != 0xffffffff)
 		{
+			recBlocks.Link(HWADDR(newpc), xJcc32(Jcc_Signed));
+
+			xFastCall((void*)iopEventTest);
+
 			xCMP(ptr32[&psxRegs.pc], newpc);
 			xJNE(iopDispatcherReg);
 		}
+		else
+		{
+			xForwardJS<u8> nointerruptpending;
+
+			xFastCall((void*)iopEventTest);
 
-		nointerruptpending.SetTarget();
+			nointerruptpending.SetTarget();
+		}
 	}
 }
 
@@ -1556,6 +1580,13 @@ static void PreBlockCheck(u32 blockpc)
 }
 #endif
 
+// Returns true for the hardware registers (0x1F801000+) and the SPU2 (0x1F900000+).
+static bool psxIsHwRegisterAddr(u32 addr)
+{
+	addr &= 0x1FFFFFFF;
+	return ((addr >> 16) == 0x1F80 && addr >= 0x1F801000) || (addr >> 16) == 0x1F90;
+}
+
 static void iopRecRecompile(const u32 startpc)
 {
 	u32 i;
@@ -1678,24 +1709,14 @@ static void iopRecRecompile(const u32 startpc)
 
 StartRecomp:
 
+	// Same idle loop detection as the EE, which catches the status polling loops of the audio and
+	// streaming drivers. Loops polling hardware registers are left alone though, since things like
+	// the root counters change without an event, and skipping to the next event would overshoot
+	// what the loop is waiting for. The block is reused with whatever the registers hold later, so
+	// only loads from addresses the loop builds itself are known to stay clear of them.
 	s_nBlockFF = false;
 	if (s_branchTo == startpc)
-	{
-		s_nBlockFF = true;
-		for (i = startpc; i < s_nEndBlock; i += 4)
-		{
-			if (i != s_nEndBlock - 8)
-			{
-				switch (iopMemRead32(i))
-				{
-					case 0: // nop
-						break;
-					default:
-						s_nBlockFF = false;
-				}
-			}
-		}
-	}
+		s_nBlockFF = _recIsIdleLoop(startpc, s_nEndBlock, 1, iopMemRead32, true, psxIsHwRegisterAddr);
 
 	// rec info //
 	{
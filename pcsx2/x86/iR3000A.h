@@ -46,6 +46,8 @@ void _psxOnWriteReg(int reg);
 void _psxMoveGPRtoR(const x86Emitter::xRegister32& to, int fromgpr);
 void _psxMoveGPRtoM(uptr to, int fromgpr);
 
+void _psxClearRecRAM(const x86Emitter::xRegister32& addr);
+
 extern u32 psxpc; // recompiler pc
 extern int psxbranch; // set for branch
 extern u32 g_iopCyclePenalty;
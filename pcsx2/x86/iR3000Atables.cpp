@@ -49,6 +49,15 @@ extern u32 g_psxMaxRecMem;
 		/*	branch = 2; */ \
 	}
 
+// GTE operations only touch COP2 state, so the guest GPRs can stay cached across the call.
+#define REC_GTE_OP(f) \
+	static void rgte##f() \
+	{ \
+		xMOV(ptr32[&psxRegs.code], (u32)psxRegs.code); \
+		_psxFlushCall(FLUSH_NONE); \
+		xFastCall((void*)(uptr)gte##f); \
+	}
+
 extern void psxLWL();
 extern void psxLWR();
 extern void psxSWL();
@@ -1199,20 +1208,72 @@ static void rpsxLW()
 	rpsxLoad(32, false);
 }
 
-static void rpsxSB()
+static void rpsxStore(int size)
 {
 	rpsxCalcAddressOperand();
 	rpsxCalcStoreOperand();
 	_psxFlushCall(FLUSH_FULLVTLB);
-	xFastCall((void*)iopMemWrite8);
+
+	// Ram (and its mirrors) is everything below 8mb once the segment bits are dropped,
+	// and can be written directly as long as the cache isn't isolated.
+	xTEST(arg1regd, 0x1f800000);
+	xForwardJNZ8 not_ram;
+	xTEST(ptr32[&psxRegs.CP0.n.Status], 0x10000);
+	xForwardJNZ8 isolated;
+
+	// write to psM directly
+	xMOV(eax, arg1regd);
+	xAND(eax, 0x1fffff);
+
+	auto addr = xComplexAddress(r11, iopMem->Main, rax);
+	switch (size)
+	{
+		case 8:
+			xMOV(ptr8[addr], xRegister8(arg2regd));
+			break;
+		case 16:
+			xMOV(ptr16[addr], xRegister16(arg2regd));
+			break;
+		case 32:
+			xMOV(ptr32[addr], arg2regd);
+			break;
+
+			jNO_DEFAULT
+	}
+
+	xAND(arg1regd, 0x1ffffffc);
+	_psxClearRecRAM(arg1regd);
+
+	xForwardJump8 done;
+	not_ram.SetTarget();
+	isolated.SetTarget();
+
+	switch (size)
+	{
+		case 8:
+			xFastCall((void*)iopMemWrite8);
+			break;
+		case 16:
+			xFastCall((void*)iopMemWrite16);
+			break;
+		case 32:
+			xFastCall((void*)iopMemWrite32);
+			break;
+
+			jNO_DEFAULT
+	}
+
+	done.SetTarget();
+}
+
+static void rpsxSB()
+{
+	rpsxStore(8);
 }
 
 static void rpsxSH()
 {
-	rpsxCalcAddressOperand();
-	rpsxCalcStoreOperand();
-	_psxFlushCall(FLUSH_FULLVTLB);
-	xFastCall((void*)iopMemWrite16);
+	rpsxStore(16);
 }
 
 static void rpsxSW()
@@ -1225,10 +1286,7 @@ static void rpsxSW()
 		return;
 	}
 
-	rpsxCalcAddressOperand();
-	rpsxCalcStoreOperand();
-	_psxFlushCall(FLUSH_FULLVTLB);
-	xFastCall((void*)iopMemWrite32);
+	rpsxStore(32);
 }
 
 //// SLL
@@ -1995,33 +2053,105 @@ static void rpsxRFE()
 }
 
 //// COP2
-REC_GTE_FUNC(RTPS);
-REC_GTE_FUNC(NCLIP);
-REC_GTE_FUNC(OP);
-REC_GTE_FUNC(DPCS);
-REC_GTE_FUNC(INTPL);
-REC_GTE_FUNC(MVMVA);
-REC_GTE_FUNC(NCDS);
-REC_GTE_FUNC(CDP);
-REC_GTE_FUNC(NCDT);
-REC_GTE_FUNC(NCCS);
-REC_GTE_FUNC(CC);
-REC_GTE_FUNC(NCS);
-REC_GTE_FUNC(NCT);
-REC_GTE_FUNC(SQR);
-REC_GTE_FUNC(DCPL);
-REC_GTE_FUNC(DPCT);
-REC_GTE_FUNC(AVSZ3);
-REC_GTE_FUNC(AVSZ4);
-REC_GTE_FUNC(RTPT);
-REC_GTE_FUNC(GPF);
-REC_GTE_FUNC(GPL);
-REC_GTE_FUNC(NCCT);
+REC_GTE_OP(RTPS);
+REC_GTE_OP(NCLIP);
+REC_GTE_OP(OP);
+REC_GTE_OP(DPCS);
+REC_GTE_OP(INTPL);
+REC_GTE_OP(MVMVA);
+REC_GTE_OP(NCDS);
+REC_GTE_OP(CDP);
+REC_GTE_OP(NCDT);
+REC_GTE_OP(NCCS);
+REC_GTE_OP(CC);
+REC_GTE_OP(NCS);
+REC_GTE_OP(NCT);
+REC_GTE_OP(SQR);
+REC_GTE_OP(DCPL);
+REC_GTE_OP(DPCT);
+REC_GTE_OP(AVSZ3);
+REC_GTE_OP(AVSZ4);
+REC_GTE_OP(RTPT);
+REC_GTE_OP(GPF);
+REC_GTE_OP(GPL);
+REC_GTE_OP(NCCT);
 
 REC_GTE_FUNC(MFC2);
-REC_GTE_FUNC(CFC2);
 REC_GTE_FUNC(MTC2);
-REC_GTE_FUNC(CTC2);
+
+static void rgteMFC2Inline()
+{
+	// Rt = Cop2Data->Rd
+	if (!_Rt_)
+		return;
+
+	// ORGB is packed from IR1..3 on read.
+	if (_Rd_ == 29)
+	{
+		rgteMFC2();
+		return;
+	}
+
+	const int rt = _allocX86reg(X86TYPE_PSX, _Rt_, MODE_WRITE);
+	xMOV(xRegister32(rt), ptr32[&psxRegs.CP2D.r[_Rd_]]);
+	PSX_DEL_CONST(_Rt_);
+}
+
+static void rgteCFC2()
+{
+	// Rt = Cop2Ctrl->Rd
+	if (!_Rt_)
+		return;
+
+	const int rt = _allocX86reg(X86TYPE_PSX, _Rt_, MODE_WRITE);
+	xMOV(xRegister32(rt), ptr32[&psxRegs.CP2C.r[_Rd_]]);
+	PSX_DEL_CONST(_Rt_);
+}
+
+static void rgteMTC2Inline()
+{
+	// Cop2Data->Rd = Rt
+	switch (_Rd_)
+	{
+		case 8: case 9: case 10: case 11:
+			_psxMoveGPRtoR(eax, _Rt_);
+			xMOVSX(eax, ax);
+			xMOV(ptr32[&psxRegs.CP2D.r[_Rd_]], eax);
+			break;
+
+		case 15:
+			// SXY FIFO push
+			xMOV(ecx, ptr32[&psxRegs.CP2D.r[13]]);
+			xMOV(ptr32[&psxRegs.CP2D.r[12]], ecx);
+			xMOV(ecx, ptr32[&psxRegs.CP2D.r[14]]);
+			xMOV(ptr32[&psxRegs.CP2D.r[13]], ecx);
+			_psxMoveGPRtoR(eax, _Rt_);
+			xMOV(ptr32[&psxRegs.CP2D.r[14]], eax);
+			xMOV(ptr32[&psxRegs.CP2D.r[15]], eax);
+			break;
+
+		case 16: case 17: case 18: case 19:
+			_psxMoveGPRtoR(eax, _Rt_);
+			xMOVZX(eax, ax);
+			xMOV(ptr32[&psxRegs.CP2D.r[_Rd_]], eax);
+			break;
+
+		// IRGB unpacking and LZCS counting stay in the interpreter.
+		case 28: case 30:
+			rgteMTC2();
+			break;
+
+		default:
+			_psxMoveGPRtoM((uptr)&psxRegs.CP2D.r[_Rd_], _Rt_);
+			break;
+	}
+}
+
+static void rgteCTC2()
+{
+	// Cop2Ctrl->Rd = Rt
+	_psxMoveGPRtoM((uptr)&psxRegs.CP2C.r[_Rd_], _Rt_);
+}
 
 REC_GTE_FUNC(LWC2);
 REC_GTE_FUNC(SWC2);
@@ -2095,7 +2225,7 @@ void (*rpsxCP2[64])() = {
 };
 
 void (*rpsxCP2BSC[32])() = {
-	rgteMFC2, rpsxNULL, rgteCFC2, rpsxNULL, rgteMTC2, rpsxNULL, rgteCTC2, rpsxNULL,
+	rgteMFC2Inline, rpsxNULL, rgteCFC2, rpsxNULL, rgteMTC2Inline, rpsxNULL, rgteCTC2, rpsxNULL,
 	rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL,
 	rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL,
 	rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL, rpsxNULL,
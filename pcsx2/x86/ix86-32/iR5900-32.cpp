@@ -2482,87 +2482,11 @@ static void recRecompile(const u32 startpc)
 
 StartRecomp:
 
-	// The idea here is that as long as a loop doesn't write to a register it's already read
-	// (excepting registers initialised with constants or memory loads) or use any instructions
-	// which alter the machine state apart from registers, it will do the same thing on every
-	// iteration.
+	// See _recIsIdleLoop() for what makes a loop idle.
 	s_nBlockFF = false;
 	if (s_branchTo == startpc)
 	{
-		s_nBlockFF = true;
-
-		u32 reads = 0, loads = 1;
-
-		for (i = startpc; i < s_nEndBlock; i += 4)
-		{
-			if (i == s_nEndBlock - 8)
-				continue;
-			cpuRegs.code = *(u32*)PSM(i);
-			// nop
-			if (cpuRegs.code == 0)
-				continue;
-			// cache, sync
-			else if (_Opcode_ == 057 || (_Opcode_ == 0 && _Funct_ == 017))
-				continue;
-			// imm arithmetic
-			else if ((_Opcode_ & 070) == 010 || (_Opcode_ & 076) == 030)
-			{
-				if (loads & 1 << _Rs_)
-				{
-					loads |= 1 << _Rt_;
-					continue;
-				}
-				else
-					reads |= 1 << _Rs_;
-				if (reads & 1 << _Rt_)
-				{
-					s_nBlockFF = false;
-					break;
-				}
-			}
-			// common register arithmetic instructions
-			else if (_Opcode_ == 0 && (_Funct_ & 060) == 040 && (_Funct_ & 076) != 050)
-			{
-				if (loads & 1 << _Rs_ && loads & 1 << _Rt_)
-				{
-					loads |= 1 << _Rd_;
-					continue;
-				}
-				else
-					reads |= 1 << _Rs_ | 1 << _Rt_;
-				if (reads & 1 << _Rd_)
-				{
-					s_nBlockFF = false;
-					break;
-				}
-			}
-			// loads
-			else if ((_Opcode_ & 070) == 040 || (_Opcode_ & 076) == 032 || _Opcode_ == 067)
-			{
-				if (loads & 1 << _Rs_)
-				{
-					loads |= 1 << _Rt_;
-					continue;
-				}
-				else
-					reads |= 1 << _Rs_;
-				if (reads & 1 << _Rt_)
-				{
-					s_nBlockFF = false;
-					break;
-				}
-			}
-			// mfc*, cfc*
-			else if ((_Opcode_ & 074) == 020 && _Rs_ < 4)
-			{
-				loads |= 1 << _Rt_;
-			}
-			else
-			{
-				s_nBlockFF = false;
-				break;
-			}
-		}
+		s_nBlockFF = _recIsIdleLoop(startpc, s_nEndBlock, 1, [](u32 pc) { return *(u32*)PSM(pc); });
 	}
 	else
 	{
@@ -16,6 +16,7 @@
 #include "PrecompiledHeader.h"
 
 #include "Common.h"
+#include "Cache.h"
 #include "vtlb.h"
 #include "x86/iCore.h"
 #include "x86/iR5900.h"
@@ -132,6 +133,8 @@ static void __vectorcall LogWriteQuad(u32 addr, __m128i val)
 
 namespace vtlb_private
 {
+	static void DynGen_PrepValue(int value_reg, u32 sz, bool xmm);
+
 	// ------------------------------------------------------------------------
 	// Prepares eax, ecx, and, ebx for Direct or Indirect operations.
 	// Returns the writeback pointer for ebx (return address from indirect handling)
@@ -143,6 +146,18 @@ namespace vtlb_private
 		_freeX86reg(arg1regd);
 		xMOV(arg1regd, xRegister32(addr_reg));
 
+		DynGen_PrepValue(value_reg, sz, xmm);
+
+		xMOV(eax, arg1regd);
+		xSHR(eax, VTLB_PAGE_BITS);
+		xMOV(rax, ptrNative[xComplexAddress(arg3reg, vtlbdata.vmap, rax * wordsize)]);
+		xADD(arg1reg, rax);
+	}
+
+	// ------------------------------------------------------------------------
+	// Moves the data for a store to arg2reg (or the second xmm argument for quads).
+	static void DynGen_PrepValue(int value_reg, u32 sz, bool xmm)
+	{
 		if (value_reg >= 0)
 		{
 			if (sz == 128)
@@ -164,11 +179,6 @@ namespace vtlb_private
 				xMOV(arg2reg, xRegister64(value_reg));
 			}
 		}
-
-		xMOV(eax, arg1regd);
-		xSHR(eax, VTLB_PAGE_BITS);
-		xMOV(rax, ptrNative[xComplexAddress(arg3reg, vtlbdata.vmap, rax * wordsize)]);
-		xADD(arg1reg, rax);
 	}
 
 	// ------------------------------------------------------------------------
@@ -267,13 +277,26 @@ static u8* GetIndirectDispatcherPtr(int mode, int operandsize, int sign = 0)
 	return &m_IndirectDispatchers[(mode * (8 * A)) + (sign * 5 * A) + (operandsize * A)];
 }
 
+// ------------------------------------------------------------------------
+// Same as the indirect dispatchers, but for the EE cache versions of the direct accesses.
+//
+alignas(__pagesize) static u8 m_CacheDispatchers[__pagesize];
+
+static constexpr int CACHE_DISPATCHER_SIZE = 256;
+static_assert(2 * 8 * CACHE_DISPATCHER_SIZE <= sizeof(m_CacheDispatchers), "Cache dispatchers don't fit");
+
+static u8* GetCacheDispatcherPtr(int mode, int operandsize, int sign = 0)
+{
+	const int A = CACHE_DISPATCHER_SIZE;
+	return &m_CacheDispatchers[(mode * (8 * A)) + (sign * 5 * A) + (operandsize * A)];
+}
+
 // ------------------------------------------------------------------------
 // Generates a JS instruction that targets the appropriate templated instance of
 // the vtlb Indirect Dispatcher.
 //
 
-template <typename GenDirectFn>
-static void DynGen_HandlerTest(const GenDirectFn& gen_direct, int mode, int bits, bool sign = false)
+static int GetOperandSizeIndex(int bits)
 {
 	int szidx = 0;
 	switch (bits)
@@ -285,8 +308,18 @@ static void DynGen_HandlerTest(const GenDirectFn& gen_direct, int mode, int bits
 		case 128: szidx = 4; break;
 		jNO_DEFAULT;
 	}
+	return szidx;
+}
+
+template <typename GenDirectFn>
+static void DynGen_HandlerTest(const GenDirectFn& gen_direct, int mode, int bits, bool sign = false)
+{
+	const int szidx = GetOperandSizeIndex(bits);
 	xForwardJS8 to_handler;
-	gen_direct();
+	if (CHECK_CACHE)
+		xFastCall(GetCacheDispatcherPtr(mode, szidx, sign));
+	else
+		gen_direct();
 	xForwardJump8 done;
 	to_handler.SetTarget();
 	xFastCall(GetIndirectDispatcherPtr(mode, szidx, sign));
@@ -356,6 +389,103 @@ static void DynGen_IndirectTlbDispatcher(int mode, int bits, bool sign)
 	xRET();
 }
 
+// ------------------------------------------------------------------------
+// Generates the direct access used when EE cache emulation is enabled. The tag check for the
+// two ways of the set is done inline, so only misses (and the writeback they may need) call
+// into Cache.cpp. Pages which aren't cached fall through to a plain direct access.
+// In: arg1reg: host pointer, rax: vtlb entry, arg2reg/xmm1: data (if mode)
+// Out: eax/xmm0: result (if !mode)
+static void DynGen_CacheDispatcher(int mode, int bits, bool sign)
+{
+	const u32 bytes = 1u << bits;
+	const auto direct = [mode, bits, sign]() {
+		if (mode)
+			vtlb_private::DynGen_DirectWrite(8 << bits);
+		else
+			vtlb_private::DynGen_DirectRead(8 << bits, sign);
+		xRET();
+	};
+
+	// recover the guest address, and check its page is cached
+	const xRegister32 arg3regd(arg3reg.GetId());
+	xMOV(arg3regd, arg1regd);
+	xSUB(arg3regd, eax);
+	xMOV(eax, arg3regd);
+	xSHR(eax, 12);
+	xMOV(r10d, eax);
+	xSHR(eax, 5);
+	xMOV(eax, ptr32[xComplexAddress(r11, cacheablePages, rax * 4)]);
+	xBT(eax, r10d);
+	xForwardJNC32 uncached;
+
+	// r10 = set, r11 = tag we're looking for
+	xMOV(r10d, arg3regd);
+	xAND(r10d, 0xFC0);
+	xLEA(r10, ptr[r10 * 2 + r10]);
+	xMOV64(r11, (uptr)getCacheBase());
+	xADD(r10, r11);
+	xMOV(r11, arg1reg);
+	xAND(r11, ~CACHE_TAG_FLAGS);
+	xOR(r11, CACHE_TAG_VALID);
+
+	xMOV(rax, ptr64[r10]);
+	xAND(rax, ~(CACHE_TAG_FLAGS & ~CACHE_TAG_VALID));
+	xCMP(rax, r11);
+	xForwardJE8 way0;
+	xMOV(rax, ptr64[r10 + 8]);
+	xAND(rax, ~(CACHE_TAG_FLAGS & ~CACHE_TAG_VALID));
+	xCMP(rax, r11);
+	xForwardJNE8 miss;
+
+	// hit, r10 = tag, rax = line
+	xADD(r10, 8);
+	xLEA(rax, ptr[r10 + (CACHE_LINE_OFFSET + 64 - 8)]);
+	xForwardJump8 hit;
+	way0.SetTarget();
+	xLEA(rax, ptr[r10 + CACHE_LINE_OFFSET]);
+	hit.SetTarget();
+
+	if (mode)
+		xOR(ptr64[r10], CACHE_TAG_DIRTY);
+	xAND(arg3regd, 0x40 - bytes);
+	xLEA(arg1reg, ptr[rax + arg3reg]);
+	direct();
+
+	// miss, fill (and write back) the line in c++, keeping the data on the stack
+	miss.SetTarget();
+
+#ifdef _WIN32
+	static constexpr int stack_base = 32;
+#else
+	static constexpr int stack_base = 0;
+#endif
+	xSUB(rsp, stack_base + 8 + 16);
+	if (mode)
+	{
+		if (bits == 4)
+			xMOVAPS(ptr128[rsp + stack_base], xRegisterSSE::GetArgRegister(1, 0));
+		else
+			xMOV(ptr64[rsp + stack_base], arg2reg);
+	}
+
+	xMOV(arg2regd, bytes);
+	xFastCall(mode ? (void*)writeCacheLine : (void*)readCacheLine, arg3regd);
+	xMOV(arg1reg, rax);
+
+	if (mode)
+	{
+		if (bits == 4)
+			xMOVAPS(xRegisterSSE::GetArgRegister(1, 0), ptr128[rsp + stack_base]);
+		else
+			xMOV(arg2reg, ptr64[rsp + stack_base]);
+	}
+	xADD(rsp, stack_base + 8 + 16);
+	direct();
+
+	uncached.SetTarget();
+	direct();
+}
+
 // One-time initialization procedure.  Multiple subsequent calls during the lifespan of the
 // process will be ignored.
 //
@@ -388,6 +518,44 @@ void vtlb_dynarec_init()
 	HostSys::MemProtectStatic(m_IndirectDispatchers, PageAccess_ExecOnly());
 
 	Perf::any.Register(m_IndirectDispatchers, __pagesize, "TLB Dispatcher");
+
+	HostSys::MemProtectStatic(m_CacheDispatchers, PageAccess_ReadWrite());
+	memset(m_CacheDispatchers, 0xcc, __pagesize);
+
+	for (int mode = 0; mode < 2; ++mode)
+	{
+		for (int bits = 0; bits < 5; ++bits)
+		{
+			for (int sign = 0; sign < (!mode && bits < 3 ? 2 : 1); sign++)
+			{
+				u8* start = GetCacheDispatcherPtr(mode, bits, !!sign);
+				xSetPtr(start);
+
+				DynGen_CacheDispatcher(mode, bits, !!sign);
+				// Overflowing into the next dispatcher would corrupt it, so check this in release builds too.
+				pxAssertRel(xGetPtr() - start <= CACHE_DISPATCHER_SIZE, "Cache dispatcher too large");
+			}
+		}
+	}
+
+	HostSys::MemProtectStatic(m_CacheDispatchers, PageAccess_ExecOnly());
+
+	Perf::any.Register(m_CacheDispatchers, __pagesize, "Cache Dispatcher");
+}
+
+// ------------------------------------------------------------------------
+// Direct accesses to a constant address still need the cache when it's enabled, since
+// whether the page is cached can change without the block being cleared.
+static void DynGen_CacheConst(u32 addr_const, int value_reg, u32 bits, bool xmm, int mode, bool sign = false)
+{
+	const auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
+	const uptr ppf = vmv.assumePtr(addr_const);
+
+	iFlushCall(FLUSH_FULLVTLB);
+	DynGen_PrepValue(value_reg, bits, xmm);
+	xMOV64(arg1reg, ppf);
+	xMOV64(rax, ppf - addr_const);
+	xFastCall(GetCacheDispatcherPtr(mode, GetOperandSizeIndex(bits), sign));
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -485,7 +653,22 @@ int vtlb_DynGenReadNonQuad_Const(u32 bits, bool sign, bool xmm, u32 addr_const,
 
 	int x86_dest_reg;
 	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
-	if (!vmv.isHandler(addr_const))
+	if (CHECK_CACHE && !vmv.isHandler(addr_const))
+	{
+		DynGen_CacheConst(addr_const, -1, bits, xmm, 0, sign && bits < 64);
+
+		if (!xmm)
+		{
+			x86_dest_reg = dest_reg_alloc ? dest_reg_alloc() : (_freeX86reg(eax), eax.GetId());
+			xMOV(xRegister64(x86_dest_reg), rax);
+		}
+		else
+		{
+			x86_dest_reg = dest_reg_alloc ? dest_reg_alloc() : (_freeXMMreg(0), 0);
+			xMOVDZX(xRegisterSSE(x86_dest_reg), eax);
+		}
+	}
+	else if (!vmv.isHandler(addr_const))
 	{
 		auto ppf = vmv.assumePtr(addr_const);
 		if (!xmm)
@@ -632,7 +815,15 @@ int vtlb_DynGenReadQuad_Const(u32 bits, u32 addr_const, vtlb_ReadRegAllocCallbac
 
 	int reg;
 	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
-	if (!vmv.isHandler(addr_const))
+	if (CHECK_CACHE && !vmv.isHandler(addr_const))
+	{
+		DynGen_CacheConst(addr_const, -1, bits, true, 0);
+
+		reg = dest_reg_alloc ? dest_reg_alloc() : (_freeXMMreg(0), 0);
+		if (reg >= 0)
+			xMOVAPS(xRegisterSSE(reg), xmm0);
+	}
+	else if (!vmv.isHandler(addr_const))
 	{
 		void* ppf = reinterpret_cast<void*>(vmv.assumePtr(addr_const));
 		reg = dest_reg_alloc ? dest_reg_alloc() : (_freeXMMreg(0), 0);
@@ -836,7 +1027,11 @@ void vtlb_DynGenWrite_Const(u32 bits, bool xmm, u32 addr_const, int value_reg)
 #endif
 
 	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
-	if (!vmv.isHandler(addr_const))
+	if (CHECK_CACHE && !vmv.isHandler(addr_const))
+	{
+		DynGen_CacheConst(addr_const, value_reg, bits, xmm, 1);
+	}
+	else if (!vmv.isHandler(addr_const))
 	{
 		auto ppf = vmv.assumePtr(addr_const);
 		if (!xmm)
@@ -19,6 +19,8 @@
 #include "microVU.h"
 
 #include "common/AlignedMalloc.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
 #include "common/Perf.h"
 #include "common/StringUtil.h"
 
@@ -28,6 +30,13 @@
 alignas(__pagesize) static u8 vu0_RecDispatchers[mVUdispCacheSize];
 alignas(__pagesize) static u8 vu1_RecDispatchers[mVUdispCacheSize];
 
+static constexpr u32 mVUprogCacheMagic   = 0x4355564D; // 'MVUC'
+static constexpr u32 mVUprogCacheVersion = 1;          // Bump when the recorded data changes meaning
+
+static std::string s_progCacheFile;                     // File backing the program cache (empty if closed)
+static std::vector<microProgCacheEntry> s_progCache[2]; // Recorded microPrograms of mVU0/mVU1
+static bool s_progCacheDirty[2];                        // New microPrograms of mVU0/mVU1 were recorded since the file was read
+
 void mVUreserveCache(microVU& mVU)
 {
 	mVU.cache_reserve = new RecompiledCodeReserve(StringUtil::StdStringFromFormat("Micro VU%u Recompiler Cache", mVU.index));
@@ -55,6 +64,7 @@ void mVUinit(microVU& mVU, uint vuIndex)
 	mVU.exitFunct    = NULL;
 
 	mVUreserveCache(mVU);
+	mVU.prog.hashIndex = new std::unordered_map<u64, microProgram*>();
 
 	if (vuIndex)
 		mVU.dispCache = vu1_RecDispatchers;
@@ -78,6 +88,9 @@ void mVUreset(microVU& mVU, bool resetReserve)
 		}
 		VU0.VI[REG_VPU_STAT].UL &= ~0x100;
 	}
+	// Keep what was compiled so far for the persistent program cache
+	mVUrecordProgs(mVU);
+
 	// Restore reserve to uncommitted state
 	if (resetReserve)
 		mVU.cache_reserve->Reset();
@@ -102,6 +115,9 @@ void mVUreset(microVU& mVU, bool resetReserve)
 	mVU.prog.cur      = NULL;
 	mVU.prog.total    =  0;
 	mVU.prog.curFrame =  0;
+	mVU.prog.dirtyChunks = ~0ull; // Micro memory may have changed without going through mVUclear()
+	mVU.prog.quickDirtyChunks = 0; // Quick-references are all dropped below
+	mVU.prog.hashIndex->clear();
 
 	// Setup Dynarec Cache Limits for Each Program
 	u8* z = mVU.cache;
@@ -109,6 +125,11 @@ void mVUreset(microVU& mVU, bool resetReserve)
 	mVU.prog.x86ptr   = z;
 	mVU.prog.x86end   = z + ((mVU.cacheSize - mVUcacheSafeZone) * _1mb);
 
+	// Programs from the persistent cache get recompiled on next execution,
+	// unless we're only here because the rec-cache was full
+	if (resetReserve)
+		mVU.prog.warmCache = !s_progCache[mVU.index].empty();
+
 	for (u32 i = 0; i < (mVU.progSize / 2); i++)
 	{
 		if (!mVU.prog.prog[i])
@@ -134,6 +155,7 @@ void mVUclose(microVU& mVU)
 {
 
 	safe_delete(mVU.cache_reserve);
+	safe_delete(mVU.prog.hashIndex);
 
 	// Delete Programs and Block Managers
 	for (u32 i = 0; i < (mVU.progSize / 2); i++)
@@ -149,19 +171,52 @@ void mVUclose(microVU& mVU)
 	}
 }
 
+// Bitmask of the micro memory chunks touched by [addr, addr + size)
+__fi u64 mVUchunkMask(microVU& mVU, u32 addr, u32 size)
+{
+	if ((addr + size) > mVU.microMemSize || !size)
+		return ~0ull;
+
+	const u32 first = addr / mHashChunkSize;
+	const u32 count = (addr + size - 1) / mHashChunkSize - first + 1;
+	return ((count >= 64) ? ~0ull : ((1ull << count) - 1)) << first;
+}
+
 // Clears Block Data in specified range
 __fi void mVUclear(mV, u32 addr, u32 size)
 {
+	// Flag the chunks being written to, so that only they get rehashed on the next search,
+	// and only the quick-references overlapping them get dropped (see mVUvalidateQuick())
+	const u64 writeMask = mVUchunkMask(mVU, addr, size);
+	mVU.prog.dirtyChunks |= writeMask;
+	mVU.prog.quickDirtyChunks |= writeMask;
+
 	if (!mVU.prog.cleared)
 	{
 		mVU.prog.cleared = 1; // Next execution searches/creates a new microprogram
 		std::memset(&mVU.prog.lpState, 0, sizeof(mVU.prog.lpState)); // Clear pipeline state
-		for (u32 i = 0; i < (mVU.progSize / 2); i++)
+	}
+}
+
+// Drops the quick-references of programs whose recompiled ranges were written to.
+// Done once on the next search rather than per write, since microcode is often
+// streamed in with many small MPG transfers.
+__fi void mVUvalidateQuick(microVU& mVU)
+{
+	const u64 writeMask = mVU.prog.quickDirtyChunks;
+	if (!writeMask)
+		return;
+
+	for (u32 i = 0; i < (mVU.progSize / 2); i++)
+	{
+		if (mVU.prog.quick[i].prog && (mVU.prog.quick[i].prog->chunkMask & writeMask))
 		{
 			mVU.prog.quick[i].block = NULL; // Clear current quick-reference block
 			mVU.prog.quick[i].prog = NULL; // Clear current quick-reference prog
 		}
 	}
+
+	mVU.prog.quickDirtyChunks = 0;
 }
 
 //------------------------------------------------------------------
@@ -205,6 +260,12 @@ __ri void mVUcacheProg(microVU& mVU, microProgram& prog)
 	{
 		auto cmpOffset = [&](void* x) { return (u8*)x + mVUrange.start; };
 		memcpy(cmpOffset(prog.data), cmpOffset(mVU.regs().Micro), (mVUrange.end - mVUrange.start));
+		prog.chunkMask = 0;
+		for (const microRange& range : *prog.ranges)
+		{
+			const s32 end = (range.end > range.start) ? range.end : static_cast<s32>(mVU.microMemSize);
+			prog.chunkMask |= mVUchunkMask(mVU, range.start, end - range.start);
+		}
 	}
 	else
 	{
@@ -212,6 +273,7 @@ __ri void mVUcacheProg(microVU& mVU, microProgram& prog)
 			memcpy(prog.data, mVU.regs().Micro, 0x1000);
 		else
 			memcpy(prog.data, mVU.regs().Micro, 0x4000);
+		prog.chunkMask = ~0ull;
 	}
 	mVUdumpProg(mVU, prog);
 }
@@ -264,6 +326,46 @@ void mVUprintUniqueRatio(microVU& mVU)
 	DevCon.WriteLn("%d / %d [%3.1f%%]", v.size(), total, 100. - (double)v.size() / (double)total * 100.);
 }
 
+// Returns the hash of mVU.regs().Micro, only rehashing chunks that were written to
+u64 mVUmicroHash(microVU& mVU)
+{
+	if (mVU.prog.dirtyChunks)
+	{
+		const u32 numChunks = mVU.microMemSize / mHashChunkSize;
+		const u64* micro = reinterpret_cast<const u64*>(mVU.regs().Micro);
+		for (u32 i = 0; i < numChunks; i++)
+		{
+			if (!(mVU.prog.dirtyChunks & (1ull << i)))
+				continue;
+
+			u64 hash = 0xcbf29ce484222325ull;
+			for (u32 j = 0; j < mHashChunkSize / 8; j++)
+				hash = (hash ^ micro[i * (mHashChunkSize / 8) + j]) * 0x100000001b3ull;
+			mVU.prog.chunkHash[i] = hash ^ (hash >> 29);
+		}
+
+		mVU.prog.memHash = 0;
+		for (u32 i = 0; i < numChunks; i++)
+			mVU.prog.memHash = (mVU.prog.memHash ^ mVU.prog.chunkHash[i]) * 0x9e3779b97f4a7c15ull;
+		mVU.prog.dirtyChunks = 0;
+	}
+	return mVU.prog.memHash;
+}
+
+// Key of the hash index for programs starting at startPC (in 64-bit units)
+__fi u64 mVUhashIndexKey(microVU& mVU, u32 startPC)
+{
+	return mVUmicroHash(mVU) ^ ((u64)(startPC + 1) * 0xff51afd7ed558ccdull);
+}
+
+// Remembers the program that matched the current micro memory for startPC (in 64-bit units)
+__fi void mVUhashIndexSet(microVU& mVU, u64 key, microProgram* prog)
+{
+	if (mVU.prog.hashIndex->size() >= mVUhashIndexMax)
+		mVU.prog.hashIndex->clear();
+	(*mVU.prog.hashIndex)[key] = prog;
+}
+
 // Compare Cached microProgram to mVU.regs().Micro
 __fi bool mVUcmpProg(microVU& mVU, microProgram& prog)
 {
@@ -296,11 +398,27 @@ __fi bool mVUcmpProg(microVU& mVU, microProgram& prog)
 _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 {
 	microVU& mVU = mVUx;
+	mVUvalidateQuick(mVU);
+
 	microProgramQuick& quick = mVU.prog.quick[mVU.regs().start_pc / 8];
 	microProgramList*  list  = mVU.prog.prog [mVU.regs().start_pc / 8];
 
 	if (!quick.prog) // If null, we need to search for new program
 	{
+		// Check the program last seen with the exact same micro memory first, so that
+		// titles with many program variants don't have to compare against all of them
+		const u64 hashKey = mVUhashIndexKey(mVU, mVU.regs().start_pc / 8);
+		const auto hashIt = mVU.prog.hashIndex->find(hashKey);
+		if (hashIt != mVU.prog.hashIndex->end() && mVUcmpProg(mVU, *hashIt->second))
+		{
+			quick.block = hashIt->second->block[startPC / 8];
+			quick.prog  = hashIt->second;
+
+			if (quick.block == nullptr)
+				return mVUblockFetch(mVU, startPC, pState);
+			return mVUentryGet(mVU, quick.block, startPC, pState);
+		}
+
 		std::deque<microProgram*>::iterator it(list->begin());
 		for (; it != list->end(); ++it)
 		{
@@ -312,6 +430,7 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 				quick.prog  = it[0];
 				list->erase(it);
 				list->push_front(quick.prog);
+				mVUhashIndexSet(mVU, hashKey, quick.prog);
 
 				// Sanity check, in case for some reason the program compilation aborted half way through (JALR for example)
 				if (quick.block == nullptr)
@@ -331,11 +450,14 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 		quick.block      = mVU.prog.cur->block[startPC/8];
 		quick.prog       = mVU.prog.cur;
 		list->push_front(mVU.prog.cur);
+		mVUhashIndexSet(mVU, hashKey, mVU.prog.cur);
 		//mVUprintUniqueRatio(mVU);
 		return entryPoint;
 	}
 
 	// If list.quick, then we've already found and recompiled the program ;)
+	// (nothing it was compiled from has been written to since it was last validated)
+	mVU.prog.cleared = 0;
 	mVU.prog.isSame = -1;
 	mVU.prog.cur = quick.prog;
 	// Because the VU's can now run in sections and not whole programs at once
@@ -351,6 +473,291 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 	return mVUentryGet(mVU, quick.block, startPC, pState);
 }
 
+//------------------------------------------------------------------
+// Micro VU - Persistent Program Cache
+//------------------------------------------------------------------
+
+static bool mVUsameRanges(const std::vector<microRange>& a, const std::deque<microRange>& b)
+{
+	return (a.size() == b.size()) && std::equal(a.begin(), a.end(), b.begin(),
+		[](const microRange& x, const microRange& y) { return (x.start == y.start) && (x.end == y.end); });
+}
+
+// Records the compiled microPrograms of a VU in the persistent program cache
+void mVUrecordProgs(microVU& mVU)
+{
+	if (s_progCacheFile.empty())
+		return;
+
+	std::vector<microProgCacheEntry>& cache = s_progCache[mVU.index];
+	for (u32 pc = 0; pc < (mVU.progSize / 2); pc++)
+	{
+		microProgramList* list = mVU.prog.prog[pc];
+		if (!list)
+			continue;
+
+		for (microProgram* prog : *list)
+		{
+			// Skip programs whose compilation didn't finish cleanly
+			if (prog->ranges->empty() || std::any_of(prog->ranges->begin(), prog->ranges->end(), [&mVU](const microRange& range) {
+					return (range.start < 0) || (range.end <= range.start) || (range.end > static_cast<s32>(mVU.microMemSize));
+				}))
+			{
+				continue;
+			}
+
+			const u64 hash = mVUrangesHash(mVU, *prog);
+			auto entry = std::find_if(cache.begin(), cache.end(), [&](const microProgCacheEntry& e) {
+				return (e.startPC == pc * 8) && (e.hash == hash) && mVUsameRanges(e.ranges, *prog->ranges);
+			});
+			if (entry == cache.end())
+			{
+				if (cache.size() >= mVUprogCacheMaxProgs)
+					continue;
+
+				microProgCacheEntry& newEntry = cache.emplace_back();
+				newEntry.startPC = pc * 8;
+				newEntry.hash = hash;
+				for (const microRange& range : *prog->ranges)
+				{
+					newEntry.ranges.push_back(range);
+					newEntry.data.insert(newEntry.data.end(), &prog->data[range.start / 4], &prog->data[range.end / 4]);
+				}
+				entry = cache.end() - 1;
+				s_progCacheDirty[mVU.index] = true;
+			}
+
+			for (u32 i = 0; i < (mVU.progSize / 2); i++)
+			{
+				if (!prog->block[i])
+					continue;
+
+				prog->block[i]->forEachBlock([&](const microBlock& block) {
+					if (entry->blocks.size() >= mVUprogCacheMaxBlocks)
+						return;
+					for (const microProgCacheBlock& b : entry->blocks)
+					{
+						if ((b.startPC == i * 8) && !std::memcmp(&b.pState, &block.pState, sizeof(microRegInfo)))
+							return;
+					}
+					entry->blocks.push_back({block.pState, i * 8});
+					s_progCacheDirty[mVU.index] = true;
+				});
+			}
+		}
+	}
+}
+
+// Recompiles the microPrograms recorded in the persistent program cache, so that
+// mVUsearchProg() finds them instead of compiling them on first use in-game
+_mVUt void mVUwarmProgs()
+{
+	microVU& mVU = mVUx;
+	mVU.prog.warmCache = false;
+
+	const std::vector<microProgCacheEntry>& cache = s_progCache[vuIndex];
+	if (cache.empty())
+		return;
+
+	// Leave at least half of the rec-cache for the programs that weren't recorded
+	const u8* x86limit = mVU.prog.x86start + ((mVU.prog.x86end - mVU.prog.x86start) / 2);
+
+	// The programs are rebuilt in micro memory, so put everything back when we're done
+	const std::unique_ptr<u8[]> micro = std::make_unique<u8[]>(mVU.microMemSize);
+	std::memcpy(micro.get(), mVU.regs().Micro, mVU.microMemSize);
+	const microRegInfo lpState = mVU.prog.lpState;
+	const u32 start_pc = mVU.regs().start_pc;
+	u32 count = 0;
+
+	for (const microProgCacheEntry& entry : cache)
+	{
+		if (x86Ptr >= x86limit)
+			break;
+
+		const u32* data = entry.data.data();
+		for (const microRange& range : entry.ranges)
+		{
+			std::memcpy(mVU.regs().Micro + range.start, data, range.end - range.start);
+			data += (range.end - range.start) / 4;
+		}
+
+		mVUclear(mVU, 0, mVU.microMemSize);
+		mVU.regs().start_pc = entry.startPC;
+		for (const microProgCacheBlock& block : entry.blocks)
+			mVUsearchProg<vuIndex>(block.startPC, (uptr)&block.pState);
+		count++;
+	}
+
+	std::memcpy(mVU.regs().Micro, micro.get(), mVU.microMemSize);
+	mVUclear(mVU, 0, mVU.microMemSize);
+	mVU.prog.lpState = lpState;
+	mVU.regs().start_pc = start_pc;
+
+	DevCon.WriteLn(vuIndex ? Color_Orange : Color_Magenta, "microVU%d: Recompiled %u/%zu programs from the program cache",
+		vuIndex, count, cache.size());
+}
+
+static bool mVUreadProgCache(std::FILE* fp)
+{
+	auto read = [fp](void* ptr, size_t size) { return (size == 0) || (std::fread(ptr, size, 1, fp) == 1); };
+
+	u32 header[3];
+	if (!read(header, sizeof(header)) || header[0] != mVUprogCacheMagic || header[1] != mVUprogCacheVersion ||
+		header[2] != sizeof(microProgCacheBlock))
+	{
+		return false;
+	}
+
+	for (u32 vu = 0; vu < 2; vu++)
+	{
+		const u32 microMemSize = vu ? 0x4000 : 0x1000;
+		u32 numProgs;
+		if (!read(&numProgs, sizeof(numProgs)) || numProgs > mVUprogCacheMaxProgs)
+			return false;
+
+		for (u32 i = 0; i < numProgs; i++)
+		{
+			microProgCacheEntry entry;
+			u32 numRanges, numBlocks, dataSize = 0;
+			if (!read(&entry.startPC, sizeof(entry.startPC)) || !read(&entry.hash, sizeof(entry.hash)) ||
+				!read(&numRanges, sizeof(numRanges)) || (entry.startPC >= microMemSize) || (entry.startPC & 7) ||
+				(numRanges == 0) || (numRanges > (microMemSize / 8)))
+			{
+				return false;
+			}
+
+			entry.ranges.resize(numRanges);
+			if (!read(entry.ranges.data(), numRanges * sizeof(microRange)))
+				return false;
+			for (const microRange& range : entry.ranges)
+			{
+				if ((range.start < 0) || (range.end <= range.start) || (range.end > static_cast<s32>(microMemSize)) ||
+					((range.start | range.end) & 3))
+				{
+					return false;
+				}
+				dataSize += range.end - range.start;
+			}
+
+			entry.data.resize(dataSize / 4);
+			if (!read(entry.data.data(), dataSize) || !read(&numBlocks, sizeof(numBlocks)) ||
+				(numBlocks > mVUprogCacheMaxBlocks))
+			{
+				return false;
+			}
+
+			entry.blocks.resize(numBlocks);
+			if (!read(entry.blocks.data(), numBlocks * sizeof(microProgCacheBlock)))
+				return false;
+			for (const microProgCacheBlock& block : entry.blocks)
+			{
+				if ((block.startPC >= microMemSize) || (block.startPC & 7))
+					return false;
+			}
+
+			s_progCache[vu].push_back(std::move(entry));
+		}
+	}
+
+	return true;
+}
+
+static bool mVUwriteProgCache(std::FILE* fp)
+{
+	auto write = [fp](const void* ptr, size_t size) { return (size == 0) || (std::fwrite(ptr, size, 1, fp) == 1); };
+
+	const u32 header[3] = {mVUprogCacheMagic, mVUprogCacheVersion, sizeof(microProgCacheBlock)};
+	if (!write(header, sizeof(header)))
+		return false;
+
+	for (const std::vector<microProgCacheEntry>& cache : s_progCache)
+	{
+		const u32 numProgs = static_cast<u32>(cache.size());
+		if (!write(&numProgs, sizeof(numProgs)))
+			return false;
+
+		for (const microProgCacheEntry& entry : cache)
+		{
+			const u32 numRanges = static_cast<u32>(entry.ranges.size());
+			const u32 numBlocks = static_cast<u32>(entry.blocks.size());
+			if (!write(&entry.startPC, sizeof(entry.startPC)) || !write(&entry.hash, sizeof(entry.hash)) ||
+				!write(&numRanges, sizeof(numRanges)) || !write(entry.ranges.data(), numRanges * sizeof(microRange)) ||
+				!write(entry.data.data(), entry.data.size() * sizeof(u32)) || !write(&numBlocks, sizeof(numBlocks)) ||
+				!write(entry.blocks.data(), numBlocks * sizeof(microProgCacheBlock)))
+			{
+				return false;
+			}
+		}
+	}
+
+	return (std::fflush(fp) == 0);
+}
+
+void mVUopenProgramCache(const std::string& serial, u32 crc)
+{
+	mVUcloseProgramCache();
+
+	if (!EmuConfig.Cpu.Recompiler.EnableVUProgramCache || (serial.empty() && crc == 0))
+		return;
+
+	const std::string dir = Path::Combine(EmuFolders::Cache, "vu_programs");
+	if (!FileSystem::EnsureDirectoryExists(dir.c_str(), false))
+		return;
+
+	if (THREAD_VU1)
+		vu1Thread.WaitVU();
+
+	s_progCacheFile = Path::Combine(dir, fmt::format("{}_{:08X}.bin", Path::SanitizeFileName(serial), crc));
+
+	auto fp = FileSystem::OpenManagedCFile(s_progCacheFile.c_str(), "rb");
+	if (!fp)
+		return;
+
+	if (!mVUreadProgCache(fp.get()))
+	{
+		Console.Warning("microVU: Discarding invalid program cache '%s'", s_progCacheFile.c_str());
+		s_progCache[0].clear();
+		s_progCache[1].clear();
+		return;
+	}
+
+	Console.WriteLn("microVU: Loaded %zu mVU0 and %zu mVU1 programs from '%s'",
+		s_progCache[0].size(), s_progCache[1].size(), s_progCacheFile.c_str());
+	microVU0.prog.warmCache = !s_progCache[0].empty();
+	microVU1.prog.warmCache = !s_progCache[1].empty();
+}
+
+void mVUcloseProgramCache()
+{
+	if (s_progCacheFile.empty())
+		return;
+
+	if (THREAD_VU1)
+		vu1Thread.WaitVU();
+
+	mVUrecordProgs(microVU0);
+	mVUrecordProgs(microVU1);
+
+	if (s_progCacheDirty[0] || s_progCacheDirty[1])
+	{
+		auto fp = FileSystem::OpenManagedCFile(s_progCacheFile.c_str(), "wb");
+		if (!fp || !mVUwriteProgCache(fp.get()))
+		{
+			Console.Error("microVU: Failed to write program cache '%s'", s_progCacheFile.c_str());
+			fp.reset();
+			FileSystem::DeleteFilePath(s_progCacheFile.c_str());
+		}
+	}
+
+	s_progCacheFile = {};
+	s_progCache[0] = {};
+	s_progCache[1] = {};
+	microVU0.prog.warmCache = false;
+	microVU1.prog.warmCache = false;
+	s_progCacheDirty[0] = false;
+	s_progCacheDirty[1] = false;
+}
+
 //------------------------------------------------------------------
 // recMicroVU0 / recMicroVU1
 //------------------------------------------------------------------
@@ -23,6 +23,7 @@ using namespace x86Emitter;
 #include <deque>
 #include <algorithm>
 #include <memory>
+#include <unordered_map>
 #include "Common.h"
 #include "VU.h"
 #include "MTVU.h"
@@ -154,6 +155,14 @@ public:
 		}
 		return nullptr;
 	}
+	template <typename F>
+	void forEachBlock(F&& f) const
+	{
+		for (microBlockLink* linkI = qBlockList; linkI != nullptr; linkI = linkI->next)
+			f(linkI->block);
+		for (microBlockLink* linkI = fBlockList; linkI != nullptr; linkI = linkI->next)
+			f(linkI->block);
+	}
 	void printInfo(int pc, bool printQuick)
 	{
 		int listI = printQuick ? qListI : fListI;
@@ -185,6 +194,7 @@ struct microRange
 };
 
 #define mProgSize (0x4000 / 4)
+#define mHashChunkSize 0x100 // Bytes of micro memory covered by each incrementally updated hash
 struct microProgram
 {
 	u32                data [mProgSize];     // Holds a copy of the VU microProgram
@@ -192,10 +202,28 @@ struct microProgram
 	std::deque<microRange>* ranges;          // The ranges of the microProgram that have already been recompiled
 	u32 startPC; // Start PC of this program
 	int idx;     // Program index
+	u64 chunkMask; // Micro memory chunks covered by 'ranges' (see mHashChunkSize)
 };
 
 typedef std::deque<microProgram*> microProgramList;
 
+// Entry point of a microProgram block recorded in the persistent program cache
+struct microProgCacheBlock
+{
+	microRegInfo pState;  // Pipeline state the block was entered with
+	u32          startPC; // Start PC of the block (in bytes)
+};
+
+// microProgram recorded in the persistent program cache (see mVUopenProgramCache)
+struct microProgCacheEntry
+{
+	u32 startPC; // Start PC of the program (in bytes)
+	u64 hash;    // mVUrangesHash() of the program when it was recorded
+	std::vector<microRange>          ranges; // Recompiled ranges of the program
+	std::vector<u32>                 data;   // Micro memory covered by 'ranges' (packed back to back)
+	std::vector<microProgCacheBlock> blocks; // Block entry points that were compiled for the program
+};
+
 struct microProgramQuick
 {
 	microBlockManager* block; // Quick reference to valid microBlockManager for current startPC
@@ -211,6 +239,12 @@ struct microProgManager
 	int                total;              // Total Number of valid MicroPrograms
 	int                isSame;             // Current cached microProgram is Exact Same program as mVU.regs().Micro (-1 = unknown, 0 = No, 1 = Yes)
 	int                cleared;            // Micro Program is Indeterminate so must be searched for (and if no matches are found then recompile a new one)
+	bool               warmCache;          // Programs recorded in the persistent program cache still need to be recompiled
+	u64                dirtyChunks;        // Bitmask of micro memory chunks written to since their hash was computed
+	u64                quickDirtyChunks;   // Bitmask of micro memory chunks written to since the quick-references were validated
+	u64                chunkHash[mProgSize * 4 / mHashChunkSize]; // Hash of each micro memory chunk
+	u64                memHash;            // Combined hash of all micro memory chunks
+	std::unordered_map<u64, microProgram*>* hashIndex; // Last microProgram matched for a given micro memory hash and startPC
 	u32                curFrame;           // Frame Counter
 	u8*                x86ptr;             // Pointer to program's recompilation code
 	u8*                x86start;           // Start of program's rec-cache
@@ -221,6 +255,9 @@ struct microProgManager
 static const uint mVUdispCacheSize = __pagesize; // Dispatcher Cache Size (in bytes)
 static const uint mVUcacheSafeZone =  3; // Safe-Zone for program recompilation (in megabytes)
 static const uint mVUcacheReserve = 64; // mVU0, mVU1 Reserve Cache Size (in megabytes)
+static const uint mVUhashIndexMax = 0x4000; // Max entries in the micro memory hash index (per VU)
+static const uint mVUprogCacheMaxProgs  = 1024; // Max microPrograms kept in the persistent program cache (per VU)
+static const uint mVUprogCacheMaxBlocks = 256;  // Max block entry points kept per persistent microProgram
 
 struct microVU
 {
@@ -301,6 +338,8 @@ mVUop(mVUopL);
 extern void mVUcacheProg(microVU& mVU, microProgram& prog);
 extern void mVUdeleteProg(microVU& mVU, microProgram*& prog);
 _mVUt extern void* mVUsearchProg(u32 startPC, uptr pState);
+extern void mVUrecordProgs(microVU& mVU);
+_mVUt extern void mVUwarmProgs();
 extern void* mVUexecuteVU0(u32 startPC, u32 cycles);
 extern void* mVUexecuteVU1(u32 startPC, u32 cycles);
 
@@ -284,6 +284,8 @@ _mVUt void* mVUexecute(u32 startPC, u32 cycles)
 	mVU.totalCycles = cycles;
 
 	xSetPtr(mVU.prog.x86ptr); // Set x86ptr to where last program left off
+	if (mVU.prog.warmCache)
+		mVUwarmProgs<vuIndex>(); // Recompile programs recorded in the persistent cache
 	return mVUsearchProg<vuIndex>(startPC & vuLimit, (uptr)&mVU.prog.lpState); // Find and set correct program
 }
 
@@ -68,6 +68,7 @@ struct nVifStruct
 	u8*                     recWritePtr; // current write pos into the reserve
 
 	HashBucket              vifBlocks;   // Vif Blocks
+	nVifBlock               lastBlock;   // Last block run, lets streams of identical unpacks skip the hash lookup
 
 
 	nVifStruct() = default;
@@ -27,6 +27,7 @@
 static void recReset(int idx)
 {
 	nVif[idx].vifBlocks.reset();
+	std::memset(&nVif[idx].lastBlock, 0, sizeof(nVif[idx].lastBlock));
 
 	nVif[idx].recReserve->Reset();
 
@@ -300,6 +301,11 @@ void VifUnpackSSE_Dynarec::CompileRoutine()
 	if ((upkNum >= 8 && upkNum <= 10) || upkNum == 4)
 		xXOR.PS(zeroReg, zeroReg);
 
+	// Unmasked V4-32 unpacks are straight copies, so with AVX2 we can move two
+	// quadwords at a time whenever they fall in the same write cycle.
+	const bool wideCopy = x86caps.hasAVX2 && upkNum == 12 && IsUnmaskedOp();
+	bool usedWide = false;
+
 	while (vNum)
 	{
 		ShiftDisplacementWindow(dstIndirect, arg1reg);
@@ -310,7 +316,21 @@ void VifUnpackSSE_Dynarec::CompileRoutine()
 		// Determine if reads/processing can be skipped.
 		ProcessMasks();
 
-		if (vCL < cycleSize)
+		if (wideCopy && vNum >= 2 && (vCL + 1) < cycleSize)
+		{
+			xVMOVUPS(ymm0, ptr[srcIndirect]);
+			xVMOVUPS(ptr[dstIndirect], ymm0);
+
+			dstIndirect += 32;
+			srcIndirect += 32;
+
+			vNum -= 2;
+			vCL  += 2;
+			if (vCL == blockSize)
+				vCL = 0;
+			usedWide = true;
+		}
+		else if (vCL < cycleSize)
 		{
 			ModUnpack(upkNum, false);
 			xUnpack(upkNum);
@@ -346,6 +366,9 @@ void VifUnpackSSE_Dynarec::CompileRoutine()
 	if (doMode >= 2)
 		writeBackRow();
 
+	if (usedWide)
+		xVZEROUPPER();
+
 	xRET();
 }
 
@@ -428,11 +451,17 @@ _vifT __fi void dVifUnpack(const u8* data, bool isFill)
 	//	doMask >> 4, doMask ? wxsFormat( L"0x%08x", block.mask ).c_str() : L"ignored"
 	//);
 
-	// Seach in cache before trying to compile the block
-	nVifBlock* b = v.vifBlocks.find(block);
-	if (unlikely(b == nullptr))
+	// Batched unpacks tend to repeat the same block back to back, so check the last
+	// one we ran before searching in cache and trying to compile the block
+	nVifBlock* b = &v.lastBlock;
+	if (b->startPtr == 0 || b->hash_key != block.hash_key || b->key0 != key0 || b->key1 != key1)
 	{
-		b = dVifCompile<idx>(block, isFill);
+		b = v.vifBlocks.find(block);
+		if (unlikely(b == nullptr))
+		{
+			b = dVifCompile<idx>(block, isFill);
+		}
+		v.lastBlock = *b;
 	}
 
 	{ // Execute the block
@@ -0,0 +1,192 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+#include "pcsx2/EventQueue.h"
+#include <gtest/gtest.h>
+#include <optional>
+
+namespace
+{
+	// Stands in for the interrupt mask and start/delta cycles of the owner.
+	struct Events
+	{
+		std::array<std::optional<u32>, EventQueue::MAX_EVENTS> deadlines;
+
+		bool operator()(u32 id, u32* deadline) const
+		{
+			if (!deadlines[id].has_value())
+				return false;
+
+			*deadline = deadlines[id].value();
+			return true;
+		}
+	};
+
+	void Schedule(EventQueue& queue, Events& events, u32 id, u32 deadline)
+	{
+		events.deadlines[id] = deadline;
+		queue.Schedule(id, deadline, events);
+	}
+} // namespace
+
+TEST(EventQueue, Empty)
+{
+	EventQueue queue;
+	Events events;
+	u32 deadline;
+	ASSERT_FALSE(queue.Peek(&deadline, events));
+	ASSERT_FALSE(queue.IsFull());
+}
+
+TEST(EventQueue, OrdersByDeadline)
+{
+	EventQueue queue;
+	Events events;
+	Schedule(queue, events, 0, 300);
+	Schedule(queue, events, 1, 100);
+	Schedule(queue, events, 2, 200);
+
+	u32 deadline;
+	for (const u32 expected : {100u, 200u, 300u})
+	{
+		ASSERT_TRUE(queue.Peek(&deadline, events));
+		ASSERT_EQ(deadline, expected);
+		events.deadlines[expected / 100 % 3] = std::nullopt;
+	}
+	ASSERT_FALSE(queue.Peek(&deadline, events));
+}
+
+TEST(EventQueue, OrdersAcrossWrap)
+{
+	EventQueue queue;
+	Events events;
+	Schedule(queue, events, 0, 0x10);
+	Schedule(queue, events, 1, 0xFFFFFFF0u);
+	Schedule(queue, events, 2, 0xFFFFFF00u);
+
+	u32 deadline;
+	ASSERT_TRUE(queue.Peek(&deadline, events));
+	ASSERT_EQ(deadline, 0xFFFFFF00u);
+	events.deadlines[2] = std::nullopt;
+
+	ASSERT_TRUE(queue.Peek(&deadline, events));
+	ASSERT_EQ(deadline, 0xFFFFFFF0u);
+	events.deadlines[1] = std::nullopt;
+
+	ASSERT_TRUE(queue.Peek(&deadline, events));
+	ASSERT_EQ(deadline, 0x10u);
+}
+
+TEST(EventQueue, RequeuesPushedBackDeadline)
+{
+	EventQueue queue;
+	Events events;
+	Schedule(queue, events, 0, 100);
+	Schedule(queue, events, 1, 200);
+
+	// Rescheduled without going through the queue.
+	events.deadlines[0] = 300;
+
+	u32 deadline;
+	ASSERT_TRUE(queue.Peek(&deadline, events));
+	ASSERT_EQ(deadline, 200u);
+	events.deadlines[1] = std::nullopt;
+
+	ASSERT_TRUE(queue.Peek(&deadline, events));
+	ASSERT_EQ(deadline, 300u);
+}
+
+TEST(EventQueue, DropsClearedEvents)
+{
+	EventQueue queue;
+	Events events;
+	Schedule(queue, events, 0, 100);
+	Schedule(queue, events, 1, 200);
+	Schedule(queue, events, 2, 300);
+	events.deadlines[0] = std::nullopt;
+	events.deadlines[2] = std::nullopt;
+
+	u32 deadline;
+	ASSERT_TRUE(queue.Peek(&deadline, events));
+	ASSERT_EQ(deadline, 200u);
+
+	events.deadlines[1] = std::nullopt;
+	ASSERT_FALSE(queue.Peek(&deadline, events));
+
+	// Nothing stale is left behind to be returned later.
+	events.deadlines[0] = 50;
+	ASSERT_FALSE(queue.Peek(&deadline, events));
+}
+
+TEST(EventQueue, RebuildsWhenFull)
+{
+	EventQueue queue;
+	Events events;
+
+	// Rescheduling an event faster than it's serviced leaves stale entries behind.
+	Schedule(queue, events, 1, 2000);
+	for (u32 i = 1; i < EventQueue::CAPACITY; i++)
+		Schedule(queue, events, 0, 1000 - i);
+	ASSERT_TRUE(queue.IsFull());
+
+	// The next event rebuilds the queue from the current deadlines instead of being pushed.
+	Schedule(queue, events, 2, 1500);
+	ASSERT_FALSE(queue.IsFull());
+
+	u32 deadline;
+	ASSERT_TRUE(queue.Peek(&deadline, events));
+	ASSERT_EQ(deadline, 1000 - EventQueue::CAPACITY + 1);
+	events.deadlines[0] = std::nullopt;
+
+	ASSERT_TRUE(queue.Peek(&deadline, events));
+	ASSERT_EQ(deadline, 1500u);
+	events.deadlines[2] = std::nullopt;
+
+	ASSERT_TRUE(queue.Peek(&deadline, events));
+	ASSERT_EQ(deadline, 2000u);
+}
+
+TEST(EventQueue, RebuildDropsClearedEvents)
+{
+	EventQueue queue;
+	Events events;
+	Schedule(queue, events, 0, 100);
+	Schedule(queue, events, 31, 200);
+	events.deadlines[0] = std::nullopt;
+
+	queue.Rebuild(events);
+
+	u32 deadline;
+	ASSERT_TRUE(queue.Peek(&deadline, events));
+	ASSERT_EQ(deadline, 200u);
+	events.deadlines[31] = std::nullopt;
+	ASSERT_FALSE(queue.Peek(&deadline, events));
+}
+
+TEST(EventQueue, PeeksWhileFull)
+{
+	EventQueue queue;
+	Events events;
+	for (u32 i = 0; i < EventQueue::CAPACITY; i++)
+		Schedule(queue, events, 0, 100 + i);
+	ASSERT_TRUE(queue.IsFull());
+
+	// Stale entries are re-queued rather than dropped, so only a rebuild frees up space.
+	u32 deadline;
+	ASSERT_TRUE(queue.Peek(&deadline, events));
+	ASSERT_EQ(deadline, 100 + EventQueue::CAPACITY - 1);
+	ASSERT_TRUE(queue.IsFull());
+}
@@ -0,0 +1,92 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2023 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+#include "pcsx2/SIO/Memcard/MemoryCardFile.h"
+#include "pcsx2/SIO/Memcard/MemoryCardFolder.h"
+#include <gtest/gtest.h>
+
+TEST(MemoryCardFlatMap, FindMissing)
+{
+	MemoryCardFlatMap<u32> map;
+	ASSERT_TRUE(map.Empty());
+	ASSERT_EQ(map.Find(0), nullptr);
+	ASSERT_EQ(map.Find(12345), nullptr);
+	ASSERT_FALSE(map.Erase(7));
+}
+
+TEST(MemoryCardFlatMap, InsertAndFind)
+{
+	MemoryCardFlatMap<u32> map;
+	map[5] = 50;
+	map[1] = 10;
+	map[1000] = 10000;
+
+	ASSERT_FALSE(map.Empty());
+	ASSERT_NE(map.Find(5), nullptr);
+	ASSERT_EQ(*map.Find(5), 50u);
+	ASSERT_EQ(*map.Find(1), 10u);
+	ASSERT_EQ(*map.Find(1000), 10000u);
+	ASSERT_EQ(map.Find(2), nullptr);
+	ASSERT_EQ(map.Find(999), nullptr);
+
+	// Looking up an existing key doesn't reset it.
+	ASSERT_EQ(map[5], 50u);
+}
+
+TEST(MemoryCardFlatMap, EraseRecyclesValues)
+{
+	MemoryCardFlatMap<u32> map;
+	map[3] = 30;
+	map[4] = 40;
+
+	ASSERT_TRUE(map.Erase(3));
+	ASSERT_FALSE(map.Erase(3));
+	ASSERT_EQ(map.Find(3), nullptr);
+	ASSERT_EQ(*map.Find(4), 40u);
+
+	// The freed value is reused, and comes back default-initialised.
+	ASSERT_EQ(map[8], 0u);
+	ASSERT_EQ(*map.Find(4), 40u);
+
+	ASSERT_TRUE(map.Erase(4));
+	ASSERT_TRUE(map.Erase(8));
+	ASSERT_TRUE(map.Empty());
+}
+
+TEST(MemoryCardFlatMap, PointersStayValid)
+{
+	MemoryCardFlatMap<MemoryCardPage> map;
+	MemoryCardPage* first = &map[0];
+	first->raw[0] = 0xAB;
+
+	for (u32 i = 1; i < 4096; i++)
+		map[i].raw[0] = static_cast<u8>(i);
+
+	ASSERT_EQ(map.Find(0), first);
+	ASSERT_EQ(first->raw[0], 0xAB);
+}
+
+TEST(MemoryCardFlatMap, Clear)
+{
+	MemoryCardFlatMap<u32> map;
+	map[1] = 1;
+	map[2] = 2;
+	map.Clear();
+
+	ASSERT_TRUE(map.Empty());
+	ASSERT_EQ(map.Find(1), nullptr);
+	ASSERT_EQ(map[1], 0u);
+}